@@ -0,0 +1,163 @@
+///
+/// \file BenchRDS.ino
+/// \brief This sketch measures the CPU cycles of the RDSParser.
+///
+/// \author Matthias Hertel, http://www.mathertel.de
+/// \copyright Copyright (c) by Matthias Hertel.\n
+/// This work is licensed under a BSD 3-Clause license.\n
+/// See http://www.mathertel.de/License.aspx
+///
+/// \details
+/// The synthetic group streams from RDSBenchStreams.h are passed through the RDSParser
+/// and the cycles of every processData() call are measured.
+/// The same streams are used by the rdsbench tool in extras/linux to compare the cost on the host.
+///
+/// On AVR the Timer1 runs at the CPU clock without prescaler and is read around every call.
+/// On ESP8266 and ESP32 the cycle counter of the CPU is used.
+///
+/// The results are printed on the Serial port at 57600 baud as CSV:
+///
+///     scenario,groups,cycles/group,max cycles,callbacks,init cycles
+///
+/// Send any character to run the benchmark again.
+/// No radio chip is required.
+///
+/// More documentation is available at http://www.mathertel.de/Arduino
+/// Source Code is available on https://github.com/mathertel/Radio
+///
+/// History:
+/// --------
+/// * 18.10.2026 created.
+
+#include <Arduino.h>
+#include <RDSParser.h>
+
+#include "RDSBenchStreams.h"
+
+#define BENCH_GROUPS (100 * RDSBENCH_CYCLE)  ///< groups per scenario.
+
+RDSParser rds;
+RDSBenchStream stream;
+
+uint16_t callbacks;  ///< number of callbacks of the parser.
+
+void countName(const char *) {
+  callbacks++;
+}
+void countText(const char *) {
+  callbacks++;
+}
+void countTime(uint8_t, uint8_t) {
+  callbacks++;
+}
+
+
+#if defined(ARDUINO_ARCH_AVR)
+// Timer1 counts the cycles, an overflow is detected by the TOV1 flag.
+void benchSetup() {
+  TCCR1A = 0;
+  TCCR1B = _BV(CS10);
+  TIMSK1 = 0;
+}
+
+#define BENCH_START() \
+  noInterrupts(); \
+  TCNT1 = 0; \
+  TIFR1 = _BV(TOV1);
+
+#define BENCH_STOP(cycles) \
+  cycles = TCNT1; \
+  if (TIFR1 & _BV(TOV1)) cycles += 0x10000UL; \
+  interrupts();
+
+#elif defined(ESP8266) || defined(ESP32)
+void benchSetup() {}
+#define BENCH_START() uint32_t _benchStart = ESP.getCycleCount();
+#define BENCH_STOP(cycles) cycles = ESP.getCycleCount() - _benchStart;
+
+#else
+void benchSetup() {}
+#define BENCH_START() unsigned long _benchStart = micros();
+#define BENCH_STOP(cycles) cycles = (micros() - _benchStart) * (F_CPU / 1000000UL);
+#endif
+
+
+/// Measure the cycles of the measurement itself.
+uint32_t benchOverhead() {
+  uint32_t cycles;
+  BENCH_START();
+  BENCH_STOP(cycles);
+  return (cycles);
+}  // benchOverhead()
+
+
+/// Run one scenario and print a CSV line.
+void benchScenario(uint8_t scenario, uint32_t overhead) {
+  RDSBENCH_GROUP g;
+  uint32_t cycles, total = 0, high = 0, initCycles;
+
+  BENCH_START();
+  rds.init();
+  BENCH_STOP(initCycles);
+
+  stream.begin(scenario);
+  callbacks = 0;
+
+  for (uint16_t n = 0; n < BENCH_GROUPS; n++) {
+    stream.next(&g);
+    BENCH_START();
+    rds.processData(g.block1, g.block2, g.block3, g.block4, g.errors);
+    BENCH_STOP(cycles);
+    cycles = (cycles > overhead) ? cycles - overhead : 0;
+    total += cycles;
+    if (cycles > high) high = cycles;
+  }
+
+  Serial.print(RDSBenchStream::name(scenario));
+  Serial.print(',');
+  Serial.print(BENCH_GROUPS);
+  Serial.print(',');
+  Serial.print(total / BENCH_GROUPS);
+  Serial.print(',');
+  Serial.print(high);
+  Serial.print(',');
+  Serial.print(callbacks);
+  Serial.print(',');
+  Serial.println(initCycles > overhead ? initCycles - overhead : 0);
+}  // benchScenario()
+
+
+void runBenchmark() {
+  uint32_t overhead = benchOverhead();
+
+  Serial.println(F("scenario,groups,cycles/group,max cycles,callbacks,init cycles"));
+  for (uint8_t s = 0; s < RDSBENCH_SCENARIOS; s++) {
+    benchScenario(s, overhead);
+  }
+  Serial.print(F("# F_CPU="));
+  Serial.print(F_CPU);
+  Serial.print(F(" sizeof(RDSParser)="));
+  Serial.println(sizeof(RDSParser));
+}  // runBenchmark()
+
+
+void setup() {
+  Serial.begin(57600);
+  delay(500);
+  Serial.println(F("BenchRDS..."));
+
+  benchSetup();
+  rds.attachServiceNameCallback(countName);
+  rds.attachTextCallback(countText);
+  rds.attachTimeCallback(countTime);
+
+  runBenchmark();
+}  // setup()
+
+
+void loop() {
+  if (Serial.available()) {
+    while (Serial.available()) Serial.read();
+    runBenchmark();
+  }
+}  // loop()
@@ -0,0 +1,137 @@
+///
+/// \file RDSBenchStreams.h
+/// \brief Synthetic RDS group streams for benchmarking the RDSParser.
+///
+/// \author Matthias Hertel, http://www.mathertel.de
+/// \copyright Copyright (c) by Matthias Hertel.\n
+/// This work is licensed under a BSD 3-Clause license.\n
+/// See http://www.mathertel.de/License.aspx
+///
+/// \details
+/// The same streams are used by the BenchRDS sketch on the MCU and by the rdsbench tool on the host
+/// so the costs can be compared directly.
+///
+/// Every stream repeats a cycle of 24 groups: 4 service name groups (0A), 16 RDS text groups (2A),
+/// one clock time group (4A) and 3 other groups.
+///
+/// * clean: a static service name and text without errors.
+/// * noisy: like clean with random error levels on the blocks.
+/// * dynps: the service name changes every cycle.
+/// * rtab: a new text with a toggled A/B flag every cycle.
+/// * reset: a retune with a (0,0,0,0) group and a new PI code every 50 groups.
+///
+/// History:
+/// --------
+/// * 18.10.2026 created.
+
+#ifndef __RDSBENCHSTREAMS_H__
+#define __RDSBENCHSTREAMS_H__
+
+#include <Arduino.h>
+
+#define RDSBENCH_CLEAN 0
+#define RDSBENCH_NOISY 1
+#define RDSBENCH_DYNPS 2
+#define RDSBENCH_RTAB 3
+#define RDSBENCH_RESET 4
+#define RDSBENCH_SCENARIOS 5
+
+#define RDSBENCH_CYCLE 24   ///< groups in one cycle of a stream.
+#define RDSBENCH_RETUNE 50  ///< groups between the resets of the reset stream.
+
+/// A RDS group with the error levels of the blocks.
+struct RDSBENCH_GROUP {
+  uint16_t block1, block2, block3, block4;
+  uint8_t errors;
+};
+
+
+/// Generator for the synthetic group streams.
+class RDSBenchStream {
+public:
+  /// Start a stream from the beginning.
+  void begin(uint8_t scenario) {
+    _scenario = scenario;
+    _n = 0;
+    _random = 0x2545F491UL;
+  };
+
+  /// Get the next group of the stream.
+  void next(RDSBENCH_GROUP *g) {
+    static const char ps[4][9] = { "BENCH FM", "  NEWS  ", " MUSIC  ", "TRAFFIC " };
+    static const char rt[2][65] = {
+      "Benchmark text for the RDSParser with 64 characters in 16 groups",
+      "Another text that is sent after toggling the A/B flag of the RT "
+    };
+
+    uint16_t cycle = _n / RDSBENCH_CYCLE;
+    uint8_t seq = _n % RDSBENCH_CYCLE;
+    const char *name = ps[(_scenario == RDSBENCH_DYNPS) ? (cycle % 4) : 0];
+    uint8_t text = (_scenario == RDSBENCH_RTAB) ? (cycle % 2) : 0;
+
+    g->block1 = 0xD301;
+    g->errors = 0;
+
+    if ((_scenario == RDSBENCH_RESET) && (_n % RDSBENCH_RETUNE == 0)) {
+      // a retune is signaled by an empty group.
+      g->block1 = g->block2 = g->block3 = g->block4 = 0;
+      _n++;
+      return;
+    }
+    if (_scenario == RDSBENCH_RESET) g->block1 += (_n / RDSBENCH_RETUNE) % 4;
+
+    if (seq < 4) {
+      g->block2 = (0x0 << 12) | seq;
+      g->block3 = 0xE0CD;
+      g->block4 = (name[2 * seq] << 8) | name[2 * seq + 1];
+
+    } else if (seq < 20) {
+      uint8_t s = seq - 4;
+      g->block2 = (0x2 << 12) | (text << 4) | s;
+      g->block3 = (rt[text][4 * s] << 8) | rt[text][4 * s + 1];
+      g->block4 = (rt[text][4 * s + 2] << 8) | rt[text][4 * s + 3];
+
+    } else if (seq == 20) {
+      // 12:00 + 1 minute per cycle
+      uint16_t mins = (12 * 60 + cycle) % 1440;
+      g->block2 = (0x4 << 12);
+      g->block3 = ((mins / 60) >> 4) & 0x01;
+      g->block4 = (((mins / 60) & 0x0F) << 12) | ((mins % 60) << 6);
+
+    } else {
+      static const uint8_t other[3] = { 0x1, 0x8, 0xA };  // 1A, 8A and 10A are ignored by the parser.
+      g->block2 = (uint16_t)other[seq - 21] << 12;
+      g->block3 = g->block4 = 0;
+    }
+
+    if (_scenario == RDSBENCH_NOISY) {
+      // about 20% of the blocks get an error level of 1...3.
+      for (uint8_t b = 0; b < 4; b++) {
+        uint8_t r = _nextRandom() & 0x0F;
+        g->errors = (g->errors << 2) | ((r < 3) ? (r + 1) : 0);
+      }
+    }
+    _n++;
+  };
+
+  /// Name of a scenario.
+  static const char *name(uint8_t scenario) {
+    static const char names[RDSBENCH_SCENARIOS][6] = { "clean", "noisy", "dynps", "rtab", "reset" };
+    return ((scenario < RDSBENCH_SCENARIOS) ? names[scenario] : "");
+  };
+
+private:
+  uint8_t _scenario;
+  uint32_t _n;
+  uint32_t _random;
+
+  // xorshift random numbers for the same sequence on all platforms.
+  uint8_t _nextRandom() {
+    _random ^= _random << 13;
+    _random ^= _random >> 17;
+    _random ^= _random << 5;
+    return ((uint8_t)_random);
+  };
+};  // RDSBenchStream
+
+#endif  // __RDSBENCHSTREAMS_H__
@@ -0,0 +1,375 @@
+///
+/// \file BenchRadio.ino
+/// \brief This sketch measures the timing and the bus load of the radio chip libraries.
+///
+/// \author Matthias Hertel, http://www.mathertel.de
+/// \copyright Copyright (c) by Matthias Hertel.\n
+/// This work is licensed under a BSD 3-Clause license.\n
+/// See http://www.mathertel.de/License.aspx
+///
+/// \details
+/// The benchmark runs against any radio chip by enabling the right radio object and BENCH_CHIP.
+/// The stations in benchStations should be changed to stations with RDS that can be received locally.
+///
+/// These operations are measured:
+/// * tune: setFrequency() until getRadioInfo() reports the new frequency as tuned.
+/// * seek: seekUp() until a new frequency is tuned.
+/// * radioinfo: a getRadioInfo() call.
+/// * rds-data, rds-nodata: a checkRDS() call polling the chip with and without a received group.
+/// * rds-adaptive: a checkRDS() call using the default adaptive polling.
+/// * first-pi, first-ps: the time after tuning until the first RDS group and the first complete service name.
+///
+/// The results are printed on the Serial port at 57600 baud as CSV with one line per operation:
+///
+///     chip,test,count,min us,avg us,max us,transfers/op,bytes/op,timeouts
+///
+/// The transfers and bytes are counted by the RadioBus used by the chip library.
+/// The output of several runs or chips can be combined into a table by the benchsummary tool in extras/linux.
+///
+/// Send any character to run the benchmark again.
+///
+/// Wiring
+/// ------
+/// The necessary wiring of the various chips are described in the Testxxx example sketches.
+///
+/// More documentation is available at http://www.mathertel.de/Arduino
+/// Source Code is available on https://github.com/mathertel/Radio
+///
+/// History:
+/// --------
+/// * 18.10.2026 created.
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <radio.h>
+
+// all possible radio chips included.
+#include <RDA5807M.h>
+#include <SI4703.h>
+#include <SI4705.h>
+#include <SI47xx.h>
+#include <TEA5767.h>
+
+#include <RDSParser.h>
+
+
+// ===== SI4703 specific pin wiring =====
+#define ENABLE_SI4703
+
+#ifdef ENABLE_SI4703
+#if defined(ARDUINO_ARCH_AVR)
+#define RESET_PIN 2
+#define MODE_PIN A4  // same as SDA
+
+#elif defined(ESP8266)
+#define RESET_PIN D5
+#define MODE_PIN D2  // same as SDA
+
+#elif defined(ESP32)
+#define RESET_PIN 4
+#define MODE_PIN 21  // same as SDA
+
+#endif
+#endif
+
+
+/// Create the radio instance that fits the current chip and set the name used in the CSV output:
+// RDA5807M radio;  ///< Create an instance of a RDA5807 chip radio
+SI4703 radio;  ///< Create an instance of a SI4703 chip radio.
+// SI4705 radio;    ///< Create an instance of a SI4705 chip radio.
+// SI47xx radio; ///< Create an instance of a SI4705 chip radio.
+// TEA5767  radio;  ///< Create an instance of a TEA5767 chip radio.
+
+#define BENCH_CHIP "SI4703"
+
+/// Stations used for the measurements, RDS should be available on them.
+RADIO_FREQ benchStations[] = { 8930, 9540, 10170, 10480 };
+
+#define BENCH_STATIONS (sizeof(benchStations) / sizeof(RADIO_FREQ))
+
+#define BENCH_TUNETIMEOUT 1000  ///< max. time in msec for tuning.
+#define BENCH_SEEKTIMEOUT 5000  ///< max. time in msec for seeking.
+#define BENCH_RDSTIMEOUT 10000  ///< max. time in msec for receiving the first PI and PS.
+#define BENCH_INFOCALLS 100     ///< number of getRadioInfo() calls.
+#define BENCH_RDSTIME 3000      ///< time in msec for the checkRDS() measurements per station.
+
+/// get a RDS parser
+RDSParser rds;
+
+/// The statistics of one operation.
+struct BenchStat {
+  const char *test;
+  uint16_t count;
+  uint16_t timeouts;
+  uint32_t low;
+  uint32_t high;
+  uint32_t sum;
+  uint32_t transfers;
+  uint32_t bytes;
+};
+
+BenchStat firstPI;  ///< statistics of the first PI, measured in RDS_process().
+
+// start of the current operation.
+unsigned long opStart;
+uint32_t opTransfers;
+uint32_t opBytes;
+
+bool rdsReceived;  ///< a RDS group was received since tuning.
+bool rdsGroup;     ///< a RDS group was received by the last call.
+bool psReceived;   ///< a service name was received.
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void statBegin(BenchStat *s, const char *test) {
+  memset(s, 0, sizeof(BenchStat));
+  s->test = test;
+  s->low = UINT32_MAX;
+}  // statBegin()
+
+
+void opBegin() {
+  RadioBus *bus = radio.getBus();
+  opTransfers = bus->transfers;
+  opBytes = bus->bytes;
+  opStart = micros();
+}  // opBegin()
+
+
+/// add the duration and the bus traffic since opBegin() to the statistics.
+void opEnd(BenchStat *s) {
+  uint32_t duration = micros() - opStart;
+  RadioBus *bus = radio.getBus();
+
+  s->count++;
+  s->sum += duration;
+  if (duration < s->low) s->low = duration;
+  if (duration > s->high) s->high = duration;
+  s->transfers += bus->transfers - opTransfers;
+  s->bytes += bus->bytes - opBytes;
+}  // opEnd()
+
+
+/// print the statistics as a CSV line.
+void statPrint(BenchStat *s) {
+  Serial.print(F(BENCH_CHIP));
+  Serial.print(',');
+  Serial.print(s->test);
+  Serial.print(',');
+  Serial.print(s->count);
+  Serial.print(',');
+  if (s->count) {
+    Serial.print(s->low);
+    Serial.print(',');
+    Serial.print(s->sum / s->count);
+    Serial.print(',');
+    Serial.print(s->high);
+    Serial.print(',');
+    Serial.print((float)s->transfers / s->count, 1);
+    Serial.print(',');
+    Serial.print((float)s->bytes / s->count, 1);
+  } else {
+    Serial.print(F(",,,,"));
+  }
+  Serial.print(',');
+  Serial.println(s->timeouts);
+}  // statPrint()
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void RDS_process(uint16_t block1, uint16_t block2, uint16_t block3, uint16_t block4) {
+  if (!rdsReceived) {
+    rdsReceived = true;
+    opEnd(&firstPI);
+  }
+  rdsGroup = true;
+  rds.processData(block1, block2, block3, block4);
+}
+
+void DisplayServiceName(const char *) {
+  psReceived = true;
+}
+
+
+/// wait until the chip reports the given frequency as tuned.
+/// The tuned flag of the previous station is not accepted as the frequency must match.
+bool waitTuned(RADIO_FREQ target, unsigned long timeout) {
+  RADIO_INFO info;
+  unsigned long start = millis();
+
+  do {
+    radio.getRadioInfo(&info);
+    if ((info.tuned) && (radio.getFrequency() == target)) return (true);
+  } while (millis() - start < timeout);
+  return (false);
+}  // waitTuned()
+
+
+/// wait until the chip reports a tuned frequency different from the given one after a seek.
+bool waitSeek(RADIO_FREQ from, unsigned long timeout) {
+  RADIO_INFO info;
+  unsigned long start = millis();
+
+  do {
+    radio.getRadioInfo(&info);
+    if ((info.tuned) && (radio.getFrequency() != from)) return (true);
+  } while (millis() - start < timeout);
+  return (false);
+}  // waitSeek()
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void benchTune() {
+  BenchStat s;
+
+  statBegin(&s, "tune");
+  for (uint8_t n = 0; n < BENCH_STATIONS; n++) {
+    opBegin();
+    radio.setFrequency(benchStations[n]);
+    if (waitTuned(benchStations[n], BENCH_TUNETIMEOUT)) opEnd(&s);
+    else s.timeouts++;
+  }
+  statPrint(&s);
+}  // benchTune()
+
+
+void benchSeek() {
+  BenchStat s;
+
+  statBegin(&s, "seek");
+  for (uint8_t n = 0; n < BENCH_STATIONS; n++) {
+    radio.setFrequency(benchStations[n]);
+    waitTuned(benchStations[n], BENCH_TUNETIMEOUT);
+
+    opBegin();
+    radio.seekUp(true);
+    if (waitSeek(benchStations[n], BENCH_SEEKTIMEOUT)) opEnd(&s);
+    else s.timeouts++;
+  }
+  statPrint(&s);
+}  // benchSeek()
+
+
+void benchRadioInfo() {
+  BenchStat s;
+  RADIO_INFO info;
+
+  statBegin(&s, "radioinfo");
+  for (uint8_t n = 0; n < BENCH_INFOCALLS; n++) {
+    opBegin();
+    radio.getRadioInfo(&info);
+    opEnd(&s);
+  }
+  statPrint(&s);
+}  // benchRadioInfo()
+
+
+/// measure checkRDS() calls with the given polling mode.
+/// When the chip is polled on every call the calls with and without a received group are counted separately.
+void benchCheckRDS(int pollMode) {
+  BenchStat data, noData;
+  bool always = (pollMode == RADIO_RDSPOLL_ALWAYS);
+
+  radio.setup(RADIO_RDSPOLL, pollMode);
+  statBegin(&data, always ? "rds-data" : "rds-adaptive");
+  statBegin(&noData, "rds-nodata");
+
+  // no first PI measurement in RDS_process().
+  rdsReceived = true;
+
+  for (uint8_t n = 0; n < BENCH_STATIONS; n++) {
+    radio.setFrequency(benchStations[n]);
+    waitTuned(benchStations[n], BENCH_TUNETIMEOUT);
+
+    unsigned long start = millis();
+    while (millis() - start < BENCH_RDSTIME) {
+      rdsGroup = false;
+      opBegin();
+      radio.checkRDS();
+      opEnd((always && !rdsGroup) ? &noData : &data);
+    }
+  }
+
+  statPrint(&data);
+  if (always) statPrint(&noData);
+  radio.setup(RADIO_RDSPOLL, RADIO_RDSPOLL_ADAPTIVE);
+}  // benchCheckRDS()
+
+
+/// measure the first PI and PS after tuning to the stations.
+void benchFirstRDS() {
+  BenchStat firstPS;
+
+  statBegin(&firstPI, "first-pi");
+  statBegin(&firstPS, "first-ps");
+
+  for (uint8_t n = 0; n < BENCH_STATIONS; n++) {
+    rds.init();
+    radio.setFrequency(benchStations[n]);
+    radio.clearRDS();
+    rdsReceived = psReceived = false;
+
+    // the first PI is measured by RDS_process().
+    opBegin();
+    unsigned long start = millis();
+    while ((!psReceived) && (millis() - start < BENCH_RDSTIMEOUT)) {
+      radio.checkRDS();
+    }
+    if (!rdsReceived) firstPI.timeouts++;
+    if (psReceived) opEnd(&firstPS);
+    else firstPS.timeouts++;
+  }
+  statPrint(&firstPI);
+  statPrint(&firstPS);
+}  // benchFirstRDS()
+
+
+void runBenchmark() {
+  Serial.println(F("chip,test,count,min us,avg us,max us,transfers/op,bytes/op,timeouts"));
+  benchTune();
+  benchSeek();
+  benchRadioInfo();
+  benchCheckRDS(RADIO_RDSPOLL_ALWAYS);
+  benchCheckRDS(RADIO_RDSPOLL_ADAPTIVE);
+  benchFirstRDS();
+  Serial.print(F("# F_CPU="));
+  Serial.println(F_CPU);
+}  // runBenchmark()
+
+
+void setup() {
+  Serial.begin(57600);
+  delay(500);
+  Serial.println(F("BenchRadio..."));
+
+#if defined(RESET_PIN)
+  // This is required for SI4703 chips:
+  radio.setup(RADIO_RESETPIN, RESET_PIN);
+  radio.setup(RADIO_MODEPIN, MODE_PIN);
+#endif
+
+  if (!radio.initWire(Wire)) {
+    Serial.println(F("no radio chip found."));
+    delay(4000);
+    while (1) {};
+  }
+  radio.setBandFrequency(RADIO_BAND_FM, benchStations[0]);
+  radio.setVolume(2);
+  radio.setMute(false);
+
+  radio.attachReceiveRDS(RDS_process);
+  rds.attachServiceNameCallback(DisplayServiceName);
+
+  runBenchmark();
+}  // setup()
+
+
+void loop() {
+  if (Serial.available()) {
+    while (Serial.available()) Serial.read();
+    runBenchmark();
+  }
+}  // loop()
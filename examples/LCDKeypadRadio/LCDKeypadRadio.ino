@@ -34,6 +34,7 @@
 /// * 22.03.2015 Copying to LCDKeypadRadio.
 /// * 23.01.2023 more robust, nicer LCD messages and cleanup.
 /// * 30.01.2023 avoid using analogRead() too often.
+/// * 18.10.2026 keys sampled by a timer interrupt into an event queue.
 
 #include <LiquidCrystal.h>
 
@@ -47,6 +48,7 @@
 #include <TEA5767.h>
 
 #include <RDSParser.h>
+#include <RadioInput.h>
 
 // Define some stations available at your locations here:
 // 89.30 MHz as 8930
@@ -102,7 +104,7 @@ enum KEYSTATE {
 
 // ----- forwards -----
 // You need this because the function is not returning a simple value.
-KEYSTATE getLCDKeypadKey();
+KEYSTATE readLCDKeypadKey(int v);
 
 /// The radio object has to be defined by using the class corresponding to the used chip.
 /// by uncommenting the right radio object definition.
@@ -118,13 +120,13 @@ RDA5807M radio;  ///< Create an instance of a RDA5807 chip radio
 /// get a RDS parser
 RDSParser rds;
 
+/// The keys are sampled every 10 msec. and debounced into a queue of events.
+RadioInput input;
+
 unsigned long nextFreqTime = 0;
 unsigned long nextKeyTime = 0;
 unsigned long nextClearTime = 0;
 
-bool doReportKey = false;
-KEYSTATE lastKey = KEYSTATE_NONE;
-
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -176,19 +178,15 @@ void RDS_process(uint16_t block1, uint16_t block2, uint16_t block3, uint16_t blo
 }
 
 
-/// This function determines the current pressed key but
-/// * doesn't return short key down situations that are key signal bouncing.
-/// * returns a specific key down only once.
+/// This function determines the current pressed key from the value of the analog0 pin.
+/// Bouncing is removed by the RadioInput and every key down is reported once as an event.
 ///
 /// [Next] [seek--] [Vol+] [seek++] [RST]
 ///                 [Vol-]
 ///
-KEYSTATE getLCDKeypadKey() {
+KEYSTATE readLCDKeypadKey(int v) {
   KEYSTATE newKey = KEYSTATE_NONE;
 
-  // Get current key state
-  int v = analogRead(A0);  // the buttons are read from the analog0 pin
-
   if (v < 100) {
     newKey = KEYSTATE_RIGHT;
   } else if (v < 200) {
@@ -202,19 +200,33 @@ KEYSTATE getLCDKeypadKey() {
   } else {
     newKey = KEYSTATE_NONE;
   }
+  return (newKey);
+}  // readLCDKeypadKey()
 
-  if (newKey != lastKey) {
-    // a new situation - just remember but do not return anything pressed.
-    doReportKey = true;
-    lastKey = newKey;
-    return (KEYSTATE_NONE);
 
-  } else if ((newKey == lastKey) && (doReportKey)) {
-    doReportKey = false;  // don't report twice
-    return (newKey);
+#if defined(ARDUINO_ARCH_AVR)
+// The compare interrupt of timer 0 is used in addition to the overflow interrupt for millis()
+// and samples the keys every 10 msec. so no key is lost while the radio chip is busy.
+// analogRead() would wait about 110 usec for the conversion, so the interrupt reads the result
+// of the conversion started by the previous sample and starts the next one.
+ISR(TIMER0_COMPA_vect) {
+  static uint8_t ticks = 0;
+  if (++ticks >= 10) {
+    ticks = 0;
+    if (!(ADCSRA & _BV(ADSC))) {
+      input.keyTick(readLCDKeypadKey(ADC));
+      ADCSRA |= _BV(ADSC);
+    }
   }
-  return (KEYSTATE_NONE);
-}  // getLCDKeypadKey()
+}
+
+void startInputTimer() {
+  analogRead(A0);  // select the analog0 pin and the reference for the conversions.
+  ADCSRA |= _BV(ADSC);
+  OCR0A = 0x80;
+  TIMSK0 |= _BV(OCIE0A);
+}
+#endif
 
 
 void displayKeyValue(const char *key, int value) {
@@ -275,6 +287,10 @@ void setup() {
   radio.attachReceiveRDS(RDS_process);
   rds.attachServiceNameCallback(DisplayServiceName);
   rds.attachTimeCallback(DisplayTime);
+
+#if defined(ARDUINO_ARCH_AVR)
+  startInputTimer();
+#endif
 }  // Setup
 
 
@@ -289,11 +305,19 @@ void loop() {
   static RADIO_FREQ lastFrequency = 0;
   RADIO_FREQ f = 0;
 
-  // detect any key press on LCD Keypad Module
-  if (now > nextKeyTime) {
-    nextKeyTime = now + 100;
+#if !defined(ARDUINO_ARCH_AVR)
+  // sample the keys in the loop when there is no timer interrupt.
+  if (now >= nextKeyTime) {
+    nextKeyTime = now + 10;
+    input.keyTick(readLCDKeypadKey(analogRead(A0)));
+  }
+#endif
 
-    KEYSTATE k = getLCDKeypadKey();
+  // detect any key press on LCD Keypad Module
+  RADIOINPUT_EVENT event;
+  while (input.pop(&event)) {
+    if (event.type != RADIOINPUT_KEYDOWN) continue;
+    KEYSTATE k = (KEYSTATE)event.value;
 
     if (k == KEYSTATE_RIGHT) {
       radio.seekUp(true);
@@ -325,7 +349,7 @@ void loop() {
       radio.setFrequency(preset[presetIndex]);
       nextClearTime = now;
     }
-  }  // if
+  }  // while
 
   // update the display from time to time
   if (now > nextFreqTime) {
@@ -0,0 +1,139 @@
+
+// LCDFrame.h contains a shadow framebuffer for character LCDs that are connected by the I2C bus.
+//
+// The texts are written into the frame and update() sends only the changed characters to the display.
+// Adjacent changes in a row are merged into one cursor move and the output is split into small chunks
+// so the I2C bus is free for polling the radio chip between the chunks.
+//
+// With a PCF8574 adapter in 4-bit mode every command and character costs one transmission of 5 bytes:
+// the address and 2 nibbles, each written with and without the enable signal.
+
+#define LCDFRAME_COLS 20  ///< max. number of columns supported.
+#define LCDFRAME_ROWS 4   ///< max. number of rows supported.
+
+#define LCDFRAME_SENDBYTES 5  ///< I2C bytes for one command or character.
+#define LCDFRAME_MERGEGAP 1   ///< unchanged characters that are rewritten instead of moving the cursor.
+#define LCDFRAME_CHUNK 8      ///< max. number of transmissions in one update() call.
+
+template <class LCD>
+class LCDFrame {
+  public:
+    LCDFrame(LCD &lcd) : _lcd(lcd)
+    {
+      _cols = _rows = 0;
+      _diff = true;
+      _busBytes = 0;
+    };
+
+    /// start using the frame after the display was cleared.
+    void begin(uint8_t cols, uint8_t rows)
+    {
+      _cols = min(cols, (uint8_t)LCDFRAME_COLS);
+      _rows = min(rows, (uint8_t)LCDFRAME_ROWS);
+      memset(_frame, ' ', sizeof(_frame));
+      memset(_shadow, ' ', sizeof(_shadow));
+      _curCol = _curRow = 0xFF;
+      _row = _col = 0;
+    };
+
+    /// Write a text into the frame that is padded by spaces or cut to the given width.
+    void setText(uint8_t col, uint8_t row, const char *text, uint8_t width)
+    {
+      if (row >= _rows) return;
+      char *f = &_frame[row][col];
+      char *s = &_shadow[row][col];
+
+      while ((width--) && (col++ < _cols)) {
+        *f++ = (*text) ? *text++ : ' ';
+        // without diff the whole field is sent again like printing it directly.
+        if (!_diff) *s = 0;
+        s++;
+      }
+    }; // setText()
+
+    /// Send the next chunk of changed characters to the display.
+    /// Call this in loop() until it returns false.
+    /// \return true when there are more changes to be sent.
+    bool update()
+    {
+      uint8_t sends = 0;
+
+      while ((_row < _rows) && (sends < LCDFRAME_CHUNK)) {
+        // find the next changed character in the row.
+        while ((_col < _cols) && (_frame[_row][_col] == _shadow[_row][_col])) _col++;
+
+        if (_col >= _cols) {
+          _row++;
+          _col = 0;
+          continue;
+        }
+
+        if ((_col != _curCol) || (_row != _curRow)) {
+          // a cursor move and at least one character must fit into the chunk.
+          if (sends + 2 > LCDFRAME_CHUNK) break;
+          _lcd.setCursor(_col, _row);
+          _curCol = _col;
+          _curRow = _row;
+          sends++;
+        }
+
+        // write this and the following changes including small gaps of unchanged characters.
+        while (_col < _cols) {
+          uint8_t next = _col;
+          while ((next < _cols) && (_frame[_row][next] == _shadow[_row][next])) next++;
+          if ((next >= _cols) || (next - _col > LCDFRAME_MERGEGAP)) break;
+          if (sends + (next - _col) + 1 > LCDFRAME_CHUNK) break;
+
+          while (_col <= next) {
+            _lcd.write(_frame[_row][_col]);
+            _shadow[_row][_col] = _frame[_row][_col];
+            _col++;
+            sends++;
+          }
+          _curCol = _col;
+        } // while
+      } // while
+
+      _busBytes += sends * LCDFRAME_SENDBYTES;
+      if (_row < _rows) return (true);
+
+      // all done, start with the first row next time.
+      _row = 0;
+      return (false);
+    }; // update()
+
+    /// Switch the diff mode off to compare with sending all written fields.
+    void setDiff(bool diff)
+    {
+      _diff = diff;
+    };
+
+    bool getDiff()
+    {
+      return (_diff);
+    };
+
+    /// I2C bytes sent to the display.
+    uint32_t getBusBytes()
+    {
+      return (_busBytes);
+    };
+
+    void resetBusBytes()
+    {
+      _busBytes = 0;
+    };
+
+  private:
+    LCD &_lcd;  ///< The display.
+    uint8_t _cols;  ///< The number of columns in use.
+    uint8_t _rows;  ///< The number of rows in use.
+    bool _diff;  ///< Send only changed characters.
+
+    char _frame[LCDFRAME_ROWS][LCDFRAME_COLS];  ///< The characters to be displayed.
+    char _shadow[LCDFRAME_ROWS][LCDFRAME_COLS];  ///< The characters on the display, 0 when unknown.
+
+    uint8_t _curCol, _curRow;  ///< The cursor position on the display, 0xFF when unknown.
+    uint8_t _col, _row;  ///< The position of the next check for changes.
+    uint32_t _busBytes;  ///< I2C bytes sent to the display.
+};
@@ -26,6 +26,10 @@
 /// * 06.10.2014 working.
 /// * 16.01.2023 improved portable interrupt handling.
 /// * 16.01.2023 ESP8266 adaption and fixes.
+/// * 18.10.2026 frequency and volume changes by requests, only the latest one is applied.
+/// * 18.10.2026 display updates by a framebuffer that sends only changed characters.
+/// * 18.10.2026 rotary encoder and menu button captured by interrupts into an event queue.
+/// * 18.10.2026 timing of the parts of the loop by RadioProfiler, printed by the p command.
 
 
 #include <Arduino.h>
@@ -40,11 +44,13 @@
 #include <TEA5767.h>
 
 #include <RDSParser.h>
+#include <RadioInput.h>
+#include <RadioProfiler.h>
 
 #include <LiquidCrystal_PCF8574.h>
+#include "LCDFrame.h"
 
 #include <RotaryEncoder.h>
-#include <OneButton.h>
 
 
 // Define some stations available at your locations here:
@@ -89,10 +95,17 @@ uint16_t presetIndex = 0;  ///< Start at Station with index = 1
 
 // ===== rotator and menu button specific pin wiring =====
 
-#if defined(ARDUINO_ARCH_AVR)
+#if defined(__AVR_ATmega2560__)
+#define ROT_PIN1 A8
+#define ROT_PIN2 A9
+#define ROT_PCINT_vect PCINT2_vect
+#define MENU_PIN A1
+
+#elif defined(ARDUINO_ARCH_AVR)
 #define ROT_PIN1 A2
 #define ROT_PIN2 A3
-#define MENU_PIN
+#define ROT_PCINT_vect PCINT1_vect
+#define MENU_PIN A1
 
 #elif defined(ESP8266)
 #define ROT_PIN1 D6
@@ -108,12 +121,19 @@ uint16_t presetIndex = 0;  ///< Start at Station with index = 1
 // to process signals from the RotaryEncoder
 RotaryEncoder encoder(ROT_PIN1, ROT_PIN2);
 
-// The https://github.com/mathertel/OneButton library is used
-// to process signals from a momentary input
-OneButton menuButton(MENU_PIN, true);
+// The encoder steps and the menu button are captured by interrupts and queued as events.
+RadioInput input;
+
+#define MENU_KEY 1           ///< the key code of the menu button.
+#define DOUBLECLICK_TIME 400  ///< max. msec. between 2 clicks of a double click.
 
-int encoderLastPos;
-unsigned long encoderLastTime;
+int menuValue;                   ///< the value changed by the rotary encoder in the menu.
+volatile RADIO_FREQ freqValue;   ///< the frequency changed by the rotary encoder interrupt.
+RADIO_FREQ freqStep;             ///< the frequency step of the band, read once for the interrupt.
+RADIO_FREQ freqMin, freqMax;     ///< the frequency range of the band, read once for the interrupt.
+unsigned long encoderLastTime;   ///< the time of the last input.
+bool clickPending = false;       ///< a click may be the first of a double click.
+uint16_t clickTime;              ///< the time of the pending click.
 
 
 // variables for rotator encoder
@@ -138,9 +158,27 @@ SI4703 radio;  // Create an instance of a SI4703 chip radio.
 
 LiquidCrystal_PCF8574 lcd(0x27);  // set the LCD address to 0x27 for a 16 chars and 2 line display
 
+// All texts are written into the frame and only the changes are sent to the display in small chunks.
+LCDFrame<LiquidCrystal_PCF8574> frame(lcd);
+
 /// get a RDS parser
 RDSParser rds;
 
+/// The timing of the parts of loop().
+#define PERF_BUDGET (20 * 1000)  ///< parts longer than 20 msec are counted as over the budget.
+
+enum PERF_SECTIONS {
+  PERF_SERIAL,
+  PERF_INPUT,
+  PERF_RADIO,
+  PERF_DISPLAY,
+  PERF_COUNT
+};
+
+const char *const perfNames[PERF_COUNT] = { "serial", "input", "radio", "display" };
+RADIOPROFILER_SECTION perfSections[PERF_COUNT];
+RadioProfiler profiler(perfSections, perfNames, PERF_COUNT);
+
 
 /// State definition for this radio implementation.
 enum RADIO_STATE {
@@ -156,19 +194,26 @@ enum RADIO_STATE {
 };
 
 RADIO_STATE state;  ///< The state variable is used for parsing input characters.
-RADIO_STATE rot_state;
+volatile RADIO_STATE rot_state;  ///< The menu state, also used by the encoder interrupt.
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 
+// set the frequency of the rotary encoder, it is also changed by the encoder interrupt.
+void setFreqValue(RADIO_FREQ f) {
+  noInterrupts();
+  freqValue = f;
+  interrupts();
+}  // setFreqValue()
+
+
 /// Update the Frequency on the LCD display.
 void DisplayFrequency() {
   char s[12];
   radio.formatFrequency(s, sizeof(s));
   Serial.print("FREQ:");
   Serial.println(s);
-  lcd.setCursor(0, 0);
-  lcd.print(s);
+  frame.setText(0, 0, s, 13);
 }  // DisplayFrequency()
 
 
@@ -177,8 +222,7 @@ void DisplayServiceName(const char *name) {
   Serial.print("RDS:");
   Serial.println(name);
   if (rot_state == STATE_FREQ) {
-    lcd.setCursor(0, 1);
-    lcd.print(name);
+    frame.setText(0, 1, name, 16);
   }
 }  // DisplayServiceName()
 
@@ -205,9 +249,7 @@ void DisplayMenuValue(String label, int value) {
   String out = label + ": " + value;
 
   Serial.println(out);
-
-  lcd.setCursor(0, 1);
-  lcd.print(out + "  ");
+  frame.setText(0, 1, out.c_str(), 16);
 }
 
 
@@ -228,27 +270,23 @@ void doMenuClick() {
   if (rot_state == STATE_FREQ) {
     // jump into volume mode
     rot_state = STATE_VOL;
-    encoderLastPos = radio.getVolume();
-    encoder.setPosition(encoderLastPos);
-    DisplayMenuValue("Vol", encoderLastPos);
+    menuValue = radio.getVolume();
+    DisplayMenuValue("Vol", menuValue);
 
   } else if (rot_state == STATE_VOL) {
     // jump into mono/stereo switch
     rot_state = STATE_MONO;
-    encoderLastPos = radio.getMono();
-    encoder.setPosition(encoderLastPos);
-    DisplayMenuValue("Mono", encoderLastPos);
+    menuValue = radio.getMono();
+    DisplayMenuValue("Mono", menuValue);
 
   } else if (rot_state == STATE_MONO) {
     // jump into soft mute switch
     rot_state = STATE_SMUTE;
-    encoderLastPos = radio.getSoftMute();
-    encoder.setPosition(encoderLastPos);
-    DisplayMenuValue("SMute", encoderLastPos);
+    menuValue = radio.getSoftMute();
+    DisplayMenuValue("SMute", menuValue);
   } else if (rot_state == STATE_SMUTE) {
+    setFreqValue(radio.getFrequency());
     rot_state = STATE_FREQ;
-    encoderLastPos = (radio.getFrequency() - radio.getMinFrequency()) / radio.getFrequencyStep();
-    encoder.setPosition(encoderLastPos);
     DisplayServiceName("...");
 
   }  // if
@@ -264,21 +302,110 @@ void doSeekClick() {
 }  // doSeekClick()
 
 
+#if !defined(IRAM_ATTR)
+#define IRAM_ATTR
+#endif
+
+// this function is called by the encoder interrupt with the new position.
+// In frequency mode the new frequency is requested at once,
+// so a tune or seek that is running in loop() is stopped by the chips that support it.
+IRAM_ATTR void encoderFrequency(long position) {
+  static long lastPosition = 0;
+
+  if ((rot_state == STATE_FREQ) && (position != lastPosition)) {
+    long f = freqValue + (position - lastPosition) * freqStep;
+    freqValue = constrain(f, (long)freqMin, (long)freqMax);
+    radio.requestFrequency(freqValue);
+  }
+  lastPosition = position;
+}  // encoderFrequency()
+
+
+// this function will be called with the steps of the rotary encoder.
+void doEncoder(int8_t steps) {
+  if (rot_state == STATE_FREQ) {
+    // the frequency was already requested by encoderFrequency().
+    rds.init();
+
+  } else if (rot_state == STATE_VOL) {
+    menuValue = constrain(menuValue + steps, 0, 15);
+    radio.requestVolume(menuValue);
+    DisplayMenuValue("Vol", menuValue);
+
+  } else if (rot_state == STATE_MONO) {
+    menuValue += steps;
+    radio.setMono(menuValue & 0x01);
+    DisplayMenuValue("Mono", menuValue & 0x01);
+
+  } else if (rot_state == STATE_SMUTE) {
+    menuValue += steps;
+    radio.setSoftMute(menuValue & 0x01);
+    DisplayMenuValue("SMute", menuValue & 0x01);
+
+  }  // if
+}  // doEncoder()
+
+
 // The Interrupt Service Routine for Pin Change Interrupts
 // On Arduino UNO you can use the PCINT1 interrupt vector that covers digital value changes on A2 and A3.
 // On Arduino Mega 2560  you can use the PCINT2 interrupt vector that covers digital value changes on A8 and A9.
 // Read http://www.atmel.com/Images/doc8468.pdf for more details on external interrupts.
+//
+// The menu button is sampled every 10 msec. by a timer interrupt and debounced by the RadioInput,
+// so a press must be stable for 30 msec. which is longer than the bouncing of the button.
 
 #if defined(ARDUINO_ARCH_AVR)
 // This interrupt routine will be called on any change of one of the input signals
-void checkPosition() {
+ISR(ROT_PCINT_vect) {
   encoder.tick();  // just call tick() to check the state.
+  input.encoderTick(encoder.getPosition());
+  encoderFrequency(encoder.getPosition());
+}
+
+// The analog pins of the encoder have no external interrupt, enable their pin change interrupts.
+void startEncoderInterrupt() {
+  *digitalPinToPCMSK(ROT_PIN1) |= _BV(digitalPinToPCMSKbit(ROT_PIN1));
+  *digitalPinToPCMSK(ROT_PIN2) |= _BV(digitalPinToPCMSKbit(ROT_PIN2));
+  PCICR |= _BV(digitalPinToPCICRbit(ROT_PIN1));
+}
+
+// The compare interrupt of timer 0 is used in addition to the overflow interrupt for millis().
+// It runs every msec. so only every 10th call samples the button.
+ISR(TIMER0_COMPA_vect) {
+  static uint8_t ticks = 0;
+  if (++ticks >= 10) {
+    ticks = 0;
+    input.keyTick(digitalRead(MENU_PIN) == LOW ? MENU_KEY : 0);
+  }
+}
+
+void startInputTimer() {
+  OCR0A = 0x80;
+  TIMSK0 |= _BV(OCIE0A);
 }
 
 #elif defined(ESP8266)
 // This interrupt routine will be called on any change of one of the input signals
 IRAM_ATTR void checkPosition() {
   encoder.tick();  // just call tick() to check the state.
+  input.encoderTick(encoder.getPosition());
+  encoderFrequency(encoder.getPosition());
+}
+
+IRAM_ATTR void checkButton() {
+  input.keyTick(digitalRead(MENU_PIN) == LOW ? MENU_KEY : 0);
+}
+
+void startEncoderInterrupt() {
+  attachInterrupt(digitalPinToInterrupt(ROT_PIN1), checkPosition, CHANGE);
+  attachInterrupt(digitalPinToInterrupt(ROT_PIN2), checkPosition, CHANGE);
+}
+
+void startInputTimer() {
+  // 80 MHz / 16 = 5 MHz, 50000 ticks = 10 msec.
+  timer1_attachInterrupt(checkButton);
+  timer1_enable(TIM_DIV16, TIM_EDGE, TIM_LOOP);
+  timer1_write(50000);
 }
 
 #endif
@@ -301,9 +428,12 @@ void setup() {
 
   delay(800);
   lcd.clear();
+  frame.begin(16, 2);
 
-  attachInterrupt(digitalPinToInterrupt(ROT_PIN1), checkPosition, CHANGE);
-  attachInterrupt(digitalPinToInterrupt(ROT_PIN2), checkPosition, CHANGE);
+  startEncoderInterrupt();
+
+  pinMode(MENU_PIN, INPUT_PULLUP);
+  startInputTimer();
 
   // This is required for SI4703 chips:
 #if defined(RESET_PIN)
@@ -324,14 +454,10 @@ void setup() {
   radio.setMute(false);
   radio.setVolume(10);
 
-  encoderLastPos = (radio.getFrequency() - radio.getMinFrequency()) / radio.getFrequencyStep();
-  encoder.setPosition(encoderLastPos);
-
-  // Setup the buttons
-  // link the doMenuClick function to be called on a click event.
-  menuButton.attachClick(doMenuClick);
-  // link the doSeekClick function to be called on a double-click event.
-  menuButton.attachDoubleClick(doSeekClick);
+  freqStep = radio.getFrequencyStep();
+  freqMin = radio.getMinFrequency();
+  freqMax = radio.getMaxFrequency();
+  setFreqValue(radio.getFrequency());
 
   Serial.println('>');
 
@@ -346,6 +472,7 @@ void setup() {
 
   rds.attachTimeCallback(DisplayTime);
 
+  profiler.setBudget(PERF_BUDGET);
   Serial.println("setup done.");
 }  // Setup
 
@@ -370,6 +497,9 @@ void runCommand(char cmd, int16_t value) {
     Serial.println("b bass boost");
     Serial.println("m mute/unmute");
     Serial.println("u soft mute/unmute");
+    Serial.println("l LCD bus bytes");
+    Serial.println("d LCD diff on/off");
+    Serial.println("p print and reset the timing of the loop");
   }
 
   // ----- control the volume and audio output -----
@@ -461,13 +591,34 @@ void runCommand(char cmd, int16_t value) {
      //  else if (cmd == 'n') { radio.debugScan(); }
   else if (cmd == 'x') { radio.debugStatus(); }
 
+  // ----- measure the i2c traffic of the display -----
+
+  else if (cmd == 'l') {
+    Serial.print("LCD bus bytes:");
+    Serial.println(frame.getBusBytes());
+    frame.resetBusBytes();
+
+  } else if (cmd == 'd') {
+    frame.setDiff(!frame.getDiff());
+    Serial.print("LCD diff:");
+    Serial.println(frame.getDiff());
+  }
+
+  // ----- timing of the loop -----
+
+  else if (cmd == 'p') {
+    profiler.print(Serial);
+    Serial.print("cost in nsec:");
+    Serial.println(RadioProfiler::getCost());
+    profiler.requestReset();  // after the measurement of this command.
+  }
+
 
 }  // runCommand()
 
 
 /// Constantly check for serial input commands and trigger command execution.
 void loop() {
-  int newPos;
   unsigned long now = millis();
   static unsigned long nextFreqTime = 0;
   static unsigned long nextRadioInfoTime = 0;
@@ -479,110 +630,113 @@ void loop() {
   RADIO_FREQ f = 0;
   char c;
 
-  // check for the menuButton
-  encoder.tick();
-  menuButton.tick();
-
   // check for commands on the Serial input
-  if (Serial.available() > 0) {
-    // read the next char from input.
-    c = Serial.peek();
-
-    if ((state == STATE_PARSECOMMAND) && (c < 0x20)) {
-      // ignore unprintable chars
-      Serial.read();
-
-    } else if (state == STATE_PARSECOMMAND) {
-      // read a command.
-      command = Serial.read();
-      state = STATE_PARSEINT;
-
-    } else if (state == STATE_PARSEINT) {
-      if ((c >= '0') && (c <= '9')) {
-        // build up the value.
-        c = Serial.read();
-        value = (value * 10) + (c - '0');
-      } else {
-        // not a value -> execute
-        runCommand(command, value);
-        command = ' ';
-        state = STATE_PARSECOMMAND;
-        value = 0;
-      }  // if
-    }    // if
-  }      // if
-
-  // check for the rotary encoder changes
-  newPos = encoder.getPosition();
-  if (newPos != encoderLastPos) {
+  {
+    RADIOPROFILE(profiler, PERF_SERIAL);
+    if (Serial.available() > 0) {
+      // read the next char from input.
+      c = Serial.peek();
+
+      if ((state == STATE_PARSECOMMAND) && (c < 0x20)) {
+        // ignore unprintable chars
+        Serial.read();
+
+      } else if (state == STATE_PARSECOMMAND) {
+        // read a command.
+        command = Serial.read();
+        state = STATE_PARSEINT;
+
+      } else if (state == STATE_PARSEINT) {
+        if ((c >= '0') && (c <= '9')) {
+          // build up the value.
+          c = Serial.read();
+          value = (value * 10) + (c - '0');
+        } else {
+          // not a value -> execute
+          runCommand(command, value);
+          command = ' ';
+          state = STATE_PARSECOMMAND;
+          value = 0;
+        }  // if
+      }    // if
+    }      // if
+  }
 
-    if (rot_state == STATE_FREQ) {
-      RADIO_FREQ f = radio.getMinFrequency() + (newPos * radio.getFrequencyStep());
-      radio.setFrequency(f);
-      rds.init();
-      encoderLastPos = newPos;
-      nextFreqTime = now + 10;
-
-    } else if (rot_state == STATE_VOL) {
-      newPos = constrain(newPos, 0, 15);
-      encoder.setPosition(newPos);
-      radio.setVolume(newPos);
-      encoderLastPos = newPos;
-      DisplayMenuValue("Vol", encoderLastPos);
-
-    } else if (rot_state == STATE_MONO) {
-      radio.setMono(newPos & 0x01);
-      encoderLastPos = newPos;
-      DisplayMenuValue("Mono", newPos & 0x01);
-
-    } else if (rot_state == STATE_SMUTE) {
-      radio.setSoftMute(newPos & 0x01);
-      encoderLastPos = newPos;
-      DisplayMenuValue("SMute", newPos & 0x01);
+  // process the inputs captured by the interrupts
+  {
+    RADIOPROFILE(profiler, PERF_INPUT);
+    RADIOINPUT_EVENT event;
+    while (input.pop(&event)) {
+      if (event.type == RADIOINPUT_ENCODER) {
+        doEncoder(event.value);
+        nextFreqTime = now + 10;
+
+      } else if ((event.type == RADIOINPUT_KEYUP) && (event.value == MENU_KEY)) {
+        // the time of the capture is used so double clicks are detected even after a long radio function.
+        if ((clickPending) && ((uint16_t)(event.time - clickTime) < DOUBLECLICK_TIME)) {
+          clickPending = false;
+          doSeekClick();
+        } else {
+          clickPending = true;
+          clickTime = event.time;
+        }
+      }  // if
+      encoderLastTime = now;
+    }  // while
+
+    if ((clickPending) && ((uint16_t)((uint16_t)millis() - clickTime) >= DOUBLECLICK_TIME)) {
+      // no double click
+      clickPending = false;
+      doMenuClick();
+
+    } else if (now > encoderLastTime + 2000) {
+      // rotary encoder was not changed since 2 seconds:
+      // fall into FREQ + RDS mode and set rotary encoder to frequency mode.
+      setFreqValue(radio.getFrequency());
+      if (rot_state != STATE_FREQ) {
+        rot_state = STATE_FREQ;
+        DisplayServiceName("");
+      }
+      encoderLastTime = now;
 
     }  // if
-    encoderLastTime = now;
-
-  } else if (now > encoderLastTime + 2000) {
-    // rotary encoder was not changed since 2 seconds:
-    // fall into FREQ + RDS mode and set rotary encoder to frequency mode.
-    if (rot_state != STATE_FREQ) {
-      DisplayServiceName("...");
-      lcd.setCursor(0, 1);
-      lcd.print("        ");
-      rot_state = STATE_FREQ;
-    }
-    encoderLastPos = (radio.getFrequency() - radio.getMinFrequency()) / radio.getFrequencyStep();
-    if (encoderLastPos != newPos) {
-      encoder.setPosition(encoderLastPos);
-    }
-    encoderLastTime = now;
+  }
 
-  }  // if
+  // apply the latest frequency and volume from the rotary encoder
+  {
+    RADIOPROFILE(profiler, PERF_RADIO);
+    radio.checkRequests();
 
-  // check for RDS data
-  radio.checkRDS();
+    // check for RDS data
+    radio.checkRDS();
+  }
 
   // update the display from time to time
-  if (now > nextFreqTime) {
-    f = radio.getFrequency();
-    if (f != lastf) {
-      // don't display a Service Name while frequency is no stable.
-      DisplayFrequency();
-      lcd.setCursor(0, 1);
-      lcd.print("        ");
-      lastf = f;
+  {
+    RADIOPROFILE(profiler, PERF_DISPLAY);
+    if (now > nextFreqTime) {
+      f = radio.getFrequency();
+      if (f != lastf) {
+        // don't display a Service Name while frequency is no stable.
+        DisplayFrequency();
+        frame.setText(0, 1, "", 16);
+        lastf = f;
+      }  // if
+      nextFreqTime = now + 400;
     }  // if
-    nextFreqTime = now + 400;
-  }  // if
 
-  if (now > nextRadioInfoTime) {
-    RADIO_INFO info;
-    radio.getRadioInfo(&info);
-    lcd.setCursor(14, 0);
-    lcd.print(info.rssi);
-    nextRadioInfoTime = now + 1000;
-  }  // update
+    if (now > nextRadioInfoTime) {
+      RADIO_INFO info;
+      radio.getRadioInfo(&info);
+      char s[4];
+      itoa(info.rssi, s, 10);
+      frame.setText(14, 0, s, 2);
+      nextRadioInfoTime = now + 1000;
+    }  // update
+
+    // send the next changes to the display, the bus is free for the radio chip in between.
+    frame.update();
+  }
 
 }  // loop
 
@@ -27,6 +27,7 @@
 /// * 27.05.2015 first version is working (beta with SI4705).
 /// * 04.07.2015 2 scan algorithms working with good results with SI4705.
 /// * 18.09.2020 more RDS output, better command handling.
+/// * 18.10.2026 optional binary frame protocol for collecting raw RDS data.
 
 #include <Arduino.h>
 #include <Wire.h>
@@ -40,6 +41,7 @@
 #include <TEA5767.h>
 
 #include <RDSParser.h>
+#include <RadioFrames.h>
 
 
 // ===== SI4703 specific pin wiring =====
@@ -96,6 +98,11 @@ bool radioDebug = false;
 bool lowLevelDebug = false;
 String lastServiceName;
 
+
+/// The binary frame protocol can be used by host tools instead of the ASCII commands.
+RadioFrames frames;
+bool binaryMode = false;  ///< binary frame protocol is active.
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 // use a function in between the radio chip and the RDS parser
@@ -104,6 +111,7 @@ void RDS_process(uint16_t block1, uint16_t block2, uint16_t block3, uint16_t blo
   // Serial.printf("RDS: 0x%04x 0x%04x 0x%04x 0x%04x\n", block1, block2, block3, block4);
   g_block1 = block1;
   rds.processData(block1, block2, block3, block4);
+  frames.sendRDS(block1, block2, block3, block4);
 }
 
 /// Update the Time
@@ -127,7 +135,7 @@ void DisplayServiceName(const char *name) {
     if (name[n] != ' ')
       found = true;
 
-  if (found) {
+  if ((found) && (!binaryMode)) {
     lastServiceName = name;
     Serial.print("Sender:<");
     Serial.print(name);
@@ -196,6 +204,7 @@ void runSerialCommand(char cmd, int16_t value) {
     Serial.println("x debug...");
     Serial.println("y toggle Debug Messages...");
     Serial.println("* toggle i2c debug output");
+    Serial.println("Bnnn binary frame protocol (n: status interval in msec.)");
 
     // ----- control the volume and audio output -----
 
@@ -383,6 +392,14 @@ void runSerialCommand(char cmd, int16_t value) {
   } else if (cmd == '*') {
     lowLevelDebug = !lowLevelDebug;
     radio._wireDebug(lowLevelDebug);
+
+  } else if (cmd == 'B') {
+    // switch to the binary frame protocol, no more text output.
+    radioDebug = false;
+    radio.debugEnable(false);
+    radio._wireDebug(false);
+    frames.setStatusInterval(value);
+    binaryMode = true;
   }
 }  // runSerialCommand()
 
@@ -428,6 +445,7 @@ void setup() {
   rds.attachServiceNameCallback(DisplayServiceName);
   // rds.attachTextCallback(DisplayText);
   // rds.attachTimeCallback(DisplayTime);
+  frames.begin(Serial, radio);
 
   runSerialCommand('?', 0);
   kbState = STATE_PARSECOMMAND;
@@ -436,7 +454,15 @@ void setup() {
 
 /// Constantly check for serial input commands and trigger command execution.
 void loop() {
-  if (Serial.available() > 0) {
+  if (binaryMode) {
+    // process binary frames until the host exits the binary mode.
+    if (!frames.loop()) {
+      binaryMode = false;
+      kbState = STATE_PARSECOMMAND;
+      kbValue = 0;
+    }
+
+  } else if (Serial.available() > 0) {
     // read the next char from input.
     char c = Serial.peek();
 
@@ -25,6 +25,8 @@
 /// * 05.08.2014 created.
 /// * 04.10.2014 working.
 /// * 15.01.2023 ESP32, cleanup compiler warnings.
+/// * 18.10.2026 optional binary frame protocol.
+/// * 18.10.2026 RDS groups with block error levels.
 
 #include <Arduino.h>
 #include <Wire.h>
@@ -40,6 +42,7 @@
 #include <TEA5767.h>
 
 #include <RDSParser.h>
+#include <RadioFrames.h>
 
 
 // Define some stations available at your locations here:
@@ -116,8 +119,14 @@ int16_t kbValue;
 bool lowLevelDebug = false;
 
 
+/// The binary frame protocol can be used by host tools instead of the ASCII commands.
+RadioFrames frames;
+bool binaryMode = false;  ///< binary frame protocol is active.
+
+
 /// Update the Frequency on the LCD display.
 void DisplayFrequency() {
+  if (binaryMode) return;
   char s[12];
   radio.formatFrequency(s, sizeof(s));
   Serial.print("FREQ:");
@@ -127,6 +136,7 @@ void DisplayFrequency() {
 
 /// Update the ServiceName text on the LCD display.
 void DisplayServiceName(const char *name) {
+  if (binaryMode) return;
   Serial.print("RDS:");
   Serial.println(name);
 }  // DisplayServiceName()
@@ -135,8 +145,12 @@ void DisplayServiceName(const char *name) {
 // - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 
-void RDS_process(uint16_t block1, uint16_t block2, uint16_t block3, uint16_t block4) {
-  rds.processData(block1, block2, block3, block4);
+void RDS_process(uint16_t block1, uint16_t block2, uint16_t block3, uint16_t block4, uint8_t errors) {
+  // the parser can use partially correct groups.
+  rds.processData(block1, block2, block3, block4, errors);
+
+  // host tools get all groups with the error levels.
+  frames.sendRDS(block1, block2, block3, block4, errors);
 }
 
 
@@ -159,6 +173,7 @@ void runSerialCommand(char cmd, int16_t value) {
     Serial.println("s mono/stereo mode");
     Serial.println("b bass boost");
     Serial.println("u mute/unmute");
+    Serial.println("Bnnn binary frame protocol (n: status interval in msec.)");
   }
 
   // ----- control the volume and audio output -----
@@ -247,6 +262,13 @@ void runSerialCommand(char cmd, int16_t value) {
   } else if (cmd == '*') {
     lowLevelDebug = !lowLevelDebug;
     radio._wireDebug(lowLevelDebug);
+
+  } else if (cmd == 'B') {
+    // switch to the binary frame protocol, no more text output.
+    radio.debugEnable(false);
+    radio._wireDebug(false);
+    frames.setStatusInterval(value);
+    binaryMode = true;
   }
 }  // runSerialCommand()
 
@@ -288,8 +310,9 @@ void setup() {
   radio.setVolume(radio.getMaxVolume() / 2);
 
   // setup the information chain for RDS data.
-  radio.attachReceiveRDS(RDS_process);
+  radio.attachReceiveRDSExt(RDS_process);
   rds.attachServiceNameCallback(DisplayServiceName);
+  frames.begin(Serial, radio);
 
   runSerialCommand('?', 0);
   kbState = STATE_PARSECOMMAND;
@@ -305,7 +328,15 @@ void loop() {
   static RADIO_FREQ lastFrequency = 0;
   RADIO_FREQ f = 0;
 
-  if (Serial.available() > 0) {
+  if (binaryMode) {
+    // process binary frames until the host exits the binary mode.
+    if (!frames.loop()) {
+      binaryMode = false;
+      kbState = STATE_PARSECOMMAND;
+      kbValue = 0;
+    }
+
+  } else if (Serial.available() > 0) {
     // read the next char from input.
     char c = Serial.peek();
 
@@ -5,22 +5,34 @@
 #define SPACE ' '
 #define QUOTE '\"'
 
+#define CHUNK_HEADLEN 6 ///< 4 hex digits and CRLF reserved at the start of a chunk.
+
 // StringBuffer is a helper class for building long texts by using an fixed allocated memory region.
+// When an output is given the buffer is sent to the output when filled up instead of truncating the text.
+// In chunked mode every part is sent as a chunk of the http chunked transfer encoding.
 
 class StringBuffer {
   public:
     /// setup a StringBuffer by passing a local char[] variable and it's size.
-    StringBuffer(char *buffer, unsigned int bufferSize)
+    StringBuffer(char *buffer, unsigned int bufferSize, Print *out = NULL)
     {
       _buf = buffer;
       _size = bufferSize;
+      _out = out;
+      _chunked = false;
       clear();
     };
 
     /// clear the buffer.
     void clear() {
-      *_buf = '\0';
       _len = 1; // The ending NUL character has to be part of the buffer;
+      _limit = _size;
+      if (_chunked) {
+        // reserve space for the chunk size at the start and CRLF at the end.
+        _len += CHUNK_HEADLEN;
+        _limit -= 2;
+      }
+      _buf[_len - 1] = NUL;
     };
 
     char *getBuffer() {
@@ -31,22 +43,78 @@ class StringBuffer {
       return(_len);
     };
 
+    /// Send out the collected text and clear the buffer.
+    /// Returns false when no output is given.
+    bool flush()
+    {
+      if (!_out) return (false);
+
+      unsigned int n = _len - 1;
+      if (_chunked) {
+        n -= CHUNK_HEADLEN;
+        if (n > 0) {
+          // complete the chunk by the size in front and CRLF at the end and send all at once.
+          static const char hex[] = "0123456789abcdef";
+          for (int i = 0; i < 4; i++) {
+            _buf[3 - i] = hex[(n >> (4 * i)) & 0x0F];
+          }
+          _buf[4] = CR;
+          _buf[5] = LF;
+          _buf[_len - 1] = CR;
+          _buf[_len] = LF;
+          _out->write((const uint8_t *)_buf, _len + 1);
+        } // if
+
+      } else if (n > 0) {
+        _out->write((const uint8_t *)_buf, n);
+      } // if
+
+      clear();
+      return (true);
+    }; // flush()
+
+
+    /// Send out the collected text and switch the chunked transfer encoding on or off for the following text.
+    void setChunked(bool chunked)
+    {
+      flush();
+      _chunked = chunked;
+      clear();
+    }; // setChunked()
+
+
+    /// Send out the collected text and the last chunk when using the chunked transfer encoding.
+    void end()
+    {
+      flush();
+      if ((_out) && (_chunked)) {
+        _out->print(F("0\r\n\r\n"));
+      }
+      _chunked = false;
+      clear();
+    }; // end()
+
+
     void append(char c)
     {
+      if ((_len >= _limit) && (!flush())) return;
+
       char *t = _buf + _len - 1;
-      if (_len < _size) {
-        *t++ = c;
-        _len++;
-      } // if
+      *t++ = c;
+      _len++;
       *t = NUL;
     }; // append()
 
     void append(const char *txt)
     {
       char *t = _buf + _len - 1;
-      char *s = (char *)txt;
-      while (_len < _size) {
-        if (! *s) break;
+      const char *s = txt;
+      while (*s) {
+        if (_len >= _limit) {
+          *t = NUL;
+          if (!flush()) break;
+          t = _buf + _len - 1;
+        }
         *t++ = *s++;
         _len++;
       }
@@ -58,11 +126,16 @@ class StringBuffer {
     {
       char *t = _buf + _len - 1;
       PGM_P s = reinterpret_cast<PGM_P>(txt);
-      while (_len < _size) {
-        unsigned char c = pgm_read_byte(s++);
-        if (! c) break;
+      unsigned char c = pgm_read_byte(s++);
+      while (c) {
+        if (_len >= _limit) {
+          *t = NUL;
+          if (!flush()) break;
+          t = _buf + _len - 1;
+        }
         *t++ = c;
         _len++;
+        c = pgm_read_byte(s++);
       }
       *t = NUL;
     }; // append()
@@ -117,11 +190,34 @@ class StringBuffer {
     } // appendQuoted()
 
 
+    /// Append a string as a JSON string with enclosing quotes.
+    /// Quotes, backslashes and all non printable or non ASCII characters are escaped.
+    void appendJSONString(const char *txt)
+    {
+      static const char hex[] = "0123456789abcdef";
+      append(QUOTE);
+      while (*txt) {
+        unsigned char c = *txt++;
+        if ((c == QUOTE) || (c == '\\')) {
+          append('\\');
+          append((char)c);
+        } else if ((c < 0x20) || (c >= 0x7F)) {
+          append("\\u00");
+          append(hex[c >> 4]);
+          append(hex[c & 0x0F]);
+        } else {
+          append((char)c);
+        }
+      } // while
+      append(QUOTE);
+    } // appendJSONString()
+
+
     /// Append an object with value in the JSON notation to the buffer.
-    void appendJSON(const char *name, char *value) {
+    void appendJSON(const char *name, const char *value) {
       appendQuoted(name);
       append(':');
-      appendQuoted(value);
+      appendJSONString(value);
     } // appendJSON()
 
 
@@ -136,6 +232,9 @@ class StringBuffer {
     char* _buf; ///< The allocated buffer
     unsigned int _size; ///< The size of the buffer.
     unsigned int _len; ///< The actual used len of the buffer.
+    unsigned int _limit; ///< The usable size of the buffer.
+    Print *_out; ///< The output for sending out the text when the buffer is filled.
+    bool _chunked; ///< Using the http chunked transfer encoding.
 
 };
 
@@ -9,6 +9,8 @@
 /// \details
 /// This is a full function radio implementation ...\n
 /// The web site is stored on the SD card. You can find the web content I used in the web folder.\n
+/// Files compressed by `gzip -9` can be stored in the /gz folder of the SD card (e.g. /gz/jcl.js) to be served to browsers instead.
+/// Keep them updated with the originals as the compressed version is preferred.\n
 /// It can be used with various chips after adjusting the radio object definition.\n
 ///
 /// Wiring
@@ -32,6 +34,12 @@
 /// * 21.10.2017 Ethernet reset wait time
 /// * 05.02.2021 Remove Compiler Warnings
 ///              Using Arduino Interrupt routine attachments 
+/// * 18.10.2026 HTTP keep-alive and pipelined requests, serving multiple sockets round-robin.
+/// * 18.10.2026 Serving pre-compressed files and ETag validation of files.
+/// * 18.10.2026 Streaming generated responses using chunked transfer encoding and escaped JSON strings.
+/// * 18.10.2026 Perfect hash tables for content types and routes.
+/// * 18.10.2026 Recording RDS groups to the SD card in the RDSLog format.
+/// * 18.10.2026 Timing of the loop functions by RadioProfiler, available by the p command and $perf.
 
 // There are several tasks that have to be done when the radio is running.
 // Therefore all these tasks are handled this way:
@@ -57,6 +65,8 @@
 // #include <TEA5767.h>
 
 #include <RDSParser.h>
+#include <RDSLog.h>
+#include <RadioProfiler.h>
 
 #include <LiquidCrystal_PCF8574.h>
 
@@ -64,6 +74,7 @@
 #include <OneButton.h>
 
 #include "StringBuffer.h"
+#include "WebTables.h"
 
 #define  ENCODER_FALLBACK (3*1000)  ///< after 3 seconds no turning fall back to tune mode.
 
@@ -130,6 +141,33 @@ unsigned long nextRadioInfoTime = 0; ///< next time for lcd update the radio inf
 /// get a RDS parser
 RDSParser rds;
 
+/// The recorder for RDS groups on the SD card.
+/// Sectors are written when no web request is active or when the buffers are almost full.
+#define RECORD_FNAME "/rdslog.bin" ///< The file for recording, new logs are appended.
+#define RECORD_SYNC 16             ///< update the directory entry every 16 sectors.
+
+RDSLog rdsLog;
+File recordFile;
+bool recording = false;     ///< RDS groups are recorded.
+uint32_t recordSectors = 0; ///< number of written sectors.
+
+/// The timing of the functions called by loop().
+#define PERF_BUDGET (50 * 1000) ///< calls longer than 50 msec are counted as over the budget.
+
+enum PERF_SECTIONS {
+  PERF_WEB,
+  PERF_BUTTONS,
+  PERF_SERIAL,
+  PERF_RADIO,
+  PERF_RECORDER,
+  PERF_LCD,
+  PERF_COUNT
+};
+
+const char *const perfNames[PERF_COUNT] = { "web", "buttons", "serial", "radio", "recorder", "lcd" };
+RADIOPROFILER_SECTION perfSections[PERF_COUNT];
+RadioProfiler profiler(perfSections, perfNames, PERF_COUNT);
+
 /// State definition for this radio implementation.
 enum RADIO_STATE {
   STATE_NONE = 0,
@@ -170,6 +208,7 @@ boolean _debugEnabled = true; ///< enable / disable local debug output and reuse
   You can reach the web server on you local network with:
   http://WIZnetEFFEED
   http://WIZnetEFFEED/$list
+  http://WIZnetEFFEED/$perf
 
 
   This sketch uses the microSD card slot on the Arduino Ethernet shield
@@ -191,38 +230,67 @@ boolean _debugEnabled = true; ///< enable / disable local debug output and reuse
 // How big our line buffer should be. 80 is plenty!
 #define LINE_BUFFERSIZE 256
 
+// Header lines are read per connection into a small buffer.
+// Longer lines are truncated as only the beginning of a few header lines is of interest.
+#define WEB_LINESIZE 64
+
+// The W5100 chip supports 4 sockets, one of them is kept for listening.
+#define WEBSERVER_CONNECTIONS (MAX_SOCK_NUM - 1)
+
+#define WEBSERVER_TIMEOUT (1200)    ///< max. time in msec. for receiving a request header or without progress on the content.
+#define WEBSERVER_KEEPALIVE (5000)  ///< max. time in msec. to keep an idle connection open.
+
+// Pre-compressed files are served when the client accepts gzip encoding.
+// The SD library on AVR only supports 8.3 filenames so the compressed files are stored in a separate folder
+// using the same names like /gz/jcl.js. With long filenames a sibling file like /jcl.js.gz is used.
+#if defined(ESP8266) || defined(ESP32)
+#define GZIP_PREFIX ""
+#define GZIP_SUFFIX ".gz"
+#else
+#define GZIP_PREFIX "/gz"
+#define GZIP_SUFFIX ""
+#endif
+
 enum WebServerState {
-  WEBSERVER_OFF,    // not running
-  WEBSERVER_IDLE,   // no current action
+  WEBSERVER_OFF,    // not running or connection not in use
+  WEBSERVER_IDLE,   // no current action, waiting for the next request line
+  READ_HEADER,  // reading the header lines of a request
   PROCESS_GET,  // a GET request is pending
   PROCESS_PUT,  // a PUT request is pending
   PROCESS_POST, // a POST request is pending
   PROCESS_ERR,  // There was an error in processing
+  SEND_FILE,    // the content of a file is sent out in chunks
   PROCESS_STOP  // stop the socket after processing or timeout
 }
 __attribute__((packed));
 
 
+/// All information of a connection to a client.
+/// Requests on a connection are processed in sequence.
+/// The following pipelined requests stay in the socket buffer until the current response is complete.
+struct WebConnection {
+  EthernetClient client;
+  WebServerState state;
+  bool http11;            ///< the client is using HTTP/1.1.
+  bool keepAlive;         ///< keep the connection open after the response is complete.
+  bool acceptGzip;        ///< the client accepts gzip content encoding.
+  bool hasETag;           ///< the client has sent an ETag by If-None-Match.
+  uint32_t etagSize;      ///< the file size from the ETag.
+  uint32_t etagStamp;     ///< the file stamp from the ETag.
+  uint8_t lineLen;        ///< used length of line
+  unsigned long timeout;  ///< time when the connection is closed without further data or progress.
+  int contentLen;         ///< remaining content bytes of the request.
+  File file;              ///< The file that is sent or received.
+  char verb[6];           ///< HTTP verb from the first line of the request
+  char uri[40];           ///< HTTP URI from the first line of the request
+  char line[WEB_LINESIZE]; ///< actual header line or the posted data.
+};
+
+
 /************ ETHERNET STUFF ************/
 byte mac[] = { 0xDE, 0xAD, 0xBE, 0xEF, 0xFE, 0xED }; // Name will be WIZnetEFFEED
 // byte ip[] = { 192, 168, 2, 250 };
 
-// CompactList for file Extension -> content-type and cache-control
-const char *CONTENTTYPES =
-  "htm text/html 1\n"
-  "css text/css 1\n"
-  "js  application/x-javascript 1\n"
-  "txt text/txt 0\n"
-  "png image/png C\n"
-  "jpg image/jpeg 1\n"
-  "ico image/x-icon 1\n"
-  "jsn application/json C"
-  //"gif image/gif C\n"
-  // ".3gp video/mpeg\n"
-  // ".pdf application/pdf\n"
-  // ".xml application/xml\n"
-  ;
-
 // The server instance listening at port 80.
 EthernetServer server(80);
 
@@ -230,15 +298,14 @@ EthernetServer server(80);
 // This is made global for speed and memory reasons.
 EthernetClient _client;
 
-WebServerState webstate;
-
-char _readBuffer[LINE_BUFFERSIZE]; ///< a buffer that is used to read a line from the request header and for reading file content.
-char _writeBuffer[LINE_BUFFERSIZE]; ///< a buffer that is used to compose a line for the reponse.
+WebServerState webstate; ///< state of the server: WEBSERVER_OFF or WEBSERVER_IDLE.
 
-char _httpVerb[6]; // HTTP verb from the first line of the request
-char _httpURI[40]; // HTTP URI from the first line of the request
+WebConnection _connections[WEBSERVER_CONNECTIONS]; ///< the open connections.
+WebConnection *_conn;  ///< The connection of the actual request.
+uint8_t _nextConnection; ///< The connection that is processed first in the next loop.
 
-int _httpContentLen;
+char _readBuffer[LINE_BUFFERSIZE]; ///< a buffer that is used for reading and writing file content.
+char _writeBuffer[LINE_BUFFERSIZE]; ///< a buffer that is used to compose a line for the reponse.
 
 // ----- http response texts -----
 
@@ -247,8 +314,11 @@ int _httpContentLen;
 #define HTTP_200      F("HTTP/1.1 200 OK\r\n")
 #define HTTP_CT       F("Content-Type: ")
 #define HTTP_200_CT   F("HTTP/1.1 200 OK\r\nContent-Type: ")
+#define HTTP_304      F("HTTP/1.1 304 Not Modified\r\n")
 #define HTTPERR_404   F("HTTP/1.1 404 Not Found\r\n")
-#define HTTP_GENERAL  F("Server: Arduino\r\nConnection: close\r\n")
+#define HTTP_GENERAL  F("Server: Arduino\r\n")
+#define HTTP_KEEPALIVE F("Connection: keep-alive\r\n")
+#define HTTP_CLOSE    F("Connection: close\r\n")
 #define HTTP_NOCACHE  F("Cache-Control: no-cache\r\n")
 #define HTTP_ENDHEAD  CRLF
 
@@ -260,7 +330,7 @@ int _httpContentLen;
 
 /// ----- forwards -----
 
-void runRadioJSONCommand(char *cmd, int16_t value);
+void runRadioJSONCommand(const char *cmd, int16_t value);
 void runRadioSerialCommand(char cmd, int16_t value);
 
 void setupRadio();
@@ -270,6 +340,9 @@ void respondRadioData();
 void loopSerial();
 void loopWebServer(unsigned long now);
 void loopButtons(unsigned long now);
+void loopRecorder(unsigned long now);
+void startRecording();
+void stopRecording();
 
 
 // ----- LCD output functions -----
@@ -318,32 +391,6 @@ void loopLCD(unsigned long now) {
 
 /// ----- Web Server interface -----
 
-/// This is a helper function that finds the entry for a given key in a table
-/// that is formatted in multiple text lines separated by \n.
-/// Each line starts with a key word and a SPACE character.
-/// The pointer to the rest of the line is returned or null.
-const char *_ctFind(const char *table, const char *key) {
-  int keyLen = strlen(key);
-
-  while ((table) && (*table)) {
-    // check for the key is reached
-    if (memcmp(table, key, keyLen) == 0) {
-      if (*(table + keyLen) == SPACE) {
-        // we found it: exit the while loop.
-        break;
-      }
-    } // if
-
-    // search next List entry.
-    table = strchr(table, '\n');
-    if (table) table++;
-  } // while
-
-  // return the position of the key.
-  return (table);
-} // _ctFind()
-
-
 /// This is a helper function that returns the position to the next word on the same line.
 /// This is done by skipping all non-SPACE characters and then all SPACE characters
 /// and returns this position.
@@ -375,13 +422,34 @@ const char *_ctCopyWord(const char *text, char *word, int wordSize)
 // One call of these function is used to send back a valid reponse header with content type or error information.
 
 
+/// Append the general header lines including the connection handling.
+/// Responses without a Content-Length can only be terminated by closing the connection.
+void appendGeneralHeader(StringBuffer &sout, bool hasLength)
+{
+  if (!hasLength) _conn->keepAlive = false;
+  sout.append(HTTP_GENERAL);
+  sout.append(_conn->keepAlive ? HTTP_KEEPALIVE : HTTP_CLOSE);
+} // appendGeneralHeader()
+
+
+/// Append the general header lines for a generated response with unknown length.
+/// HTTP/1.1 clients get the content using the chunked transfer encoding so the connection can be kept open.
+/// Call sout.setChunked(_conn->http11) after the header is complete.
+void appendChunkedHeader(StringBuffer &sout)
+{
+  if (_conn->http11) sout.append(F("Transfer-Encoding: chunked\r\n"));
+  appendGeneralHeader(sout, _conn->http11);
+} // appendChunkedHeader()
+
+
 // Response no and send not found html
 void respond404NotFound()
 {
   DEBUG_FUNC0("respond404NotFound");
   StringBuffer sout = StringBuffer(_writeBuffer, sizeof(_writeBuffer));
   sout.append(HTTPERR_404);
-  sout.append(HTTP_GENERAL);
+  appendGeneralHeader(sout, true);
+  sout.append("Content-Length: 0\r\n");
   sout.append(HTTP_ENDHEAD);
   _client.print(_writeBuffer);
 } // respond404NotFound()
@@ -393,7 +461,7 @@ void respondEmptyFile()
   DEBUG_FUNC0("respondEmptyFile");
   StringBuffer sout = StringBuffer(_writeBuffer, sizeof(_writeBuffer));
   sout.append(HTTP_200_CT); sout.append("text/html"); sout.append(CRLF);
-  sout.append(HTTP_GENERAL);
+  appendGeneralHeader(sout, true);
   sout.append("Content-Length: 0\r\n");
   sout.append(HTTP_ENDHEAD);
   _client.print(_writeBuffer);
@@ -407,20 +475,20 @@ void respondEmptyFile()
 // The root.ls call needs a lot of stack space to complete so probably this will not work on Arduino Uno.
 void respondFileList()
 {
-  StringBuffer sout = StringBuffer(_writeBuffer, sizeof(_writeBuffer));
+  StringBuffer sout = StringBuffer(_writeBuffer, sizeof(_writeBuffer), &_client);
 
   // send out a header
   sout.append(HTTP_200_CT); sout.append("text/html"); sout.append(CRLF);
-  sout.append(HTTP_GENERAL);
+  appendChunkedHeader(sout);
   sout.append(HTTP_ENDHEAD);
-  _client.print(_writeBuffer);
+  sout.setChunked(_conn->http11);
 
-  sout.clear();
   sout.append(HTML_OPEN);
   sout.append("<h2>Files on SD:</h2>");
   sout.append("<pre>");
 
   // Recursive list of all directories
+  // The buffer is sent out automatically when filled.
   File dir = SD.open("/");
   while (true) {
     File entry = dir.openNextFile();
@@ -438,19 +506,13 @@ void respondFileList()
     }
     sout.append("\r\n");
 
-    // flush buffer out when filled.
-    if (sout.getLength() > LINE_BUFFERSIZE - 32) {
-      _client.print(_writeBuffer);
-      sout.clear();
-    }
-
     entry.close();
   } // while ()
   dir.close();
 
   sout.append("</pre>");
   sout.append(HTML_CLOSE);
-  _client.print(_writeBuffer);
+  sout.end();
 
 } // respondFileList()
 
@@ -459,58 +521,141 @@ void respondFileList()
 // Send some system information to the client
 void respondSystemInfo()
 {
-  StringBuffer sout = StringBuffer(_writeBuffer, sizeof(_writeBuffer));
+  StringBuffer sout = StringBuffer(_writeBuffer, sizeof(_writeBuffer), &_client);
   sout.append(HTTP_200_CT); sout.append("text/html"); sout.append(CRLF);
-  sout.append(HTTP_GENERAL);
+  appendChunkedHeader(sout);
   sout.append(HTTP_ENDHEAD);
+  sout.setChunked(_conn->http11);
 
   sout.append(HTML_OPEN);
   sout.append("<pre>");
   sout.append("Free RAM: ");  sout.append(FreeRam());
+  sout.append("\nRecording: ");  sout.append(recording ? "on" : "off");
+  sout.append(" sectors: ");  sout.append(recordSectors);
+  sout.append(" dropped: ");  sout.append(rdsLog.dropped);
   sout.append("</pre>");
   sout.append(HTML_CLOSE);
-
-  _client.print(_writeBuffer);
+  sout.end();
 } // respondSystemInfo()
 
 
-/// Read one line of text from _client into the _readBuffer.
-void readRequestLine()
+// Response to a $perf request.
+// Send the timing of the loop functions as a table in usec.
+void respondPerfData()
+{
+  char line[RADIOPROFILER_LINE];
+  StringBuffer sout = StringBuffer(_writeBuffer, sizeof(_writeBuffer), &_client);
+  sout.append(HTTP_200_CT); sout.append("text/html"); sout.append(CRLF);
+  appendChunkedHeader(sout);
+  sout.append(HTTP_ENDHEAD);
+  sout.setChunked(_conn->http11);
+
+  sout.append(HTML_OPEN);
+  sout.append("<pre>");
+  for (uint8_t n = 0; profiler.getLine(n, line); n++) {
+    sout.append(line);
+    sout.append('\n');
+  }
+  sout.append("</pre>");
+  sout.append(HTML_CLOSE);
+  sout.end();
+} // respondPerfData()
+
+
+/// Read the available characters of a line from the client into the line buffer of the connection.
+/// Returns true when the line is complete.
+bool readRequestLine(WebConnection *c)
 {
-  uint16_t index = 0;
-  int c;
+  int ch;
 
-  while (_client.connected()) {
-    c = _client.read();
+  while (c->client.available()) {
+    ch = c->client.read();
 
-    if (c < 0) {
+    if (ch < 0) {
       // no more data available
-      // DEBUG_STR("No more data.");
       break;
 
-    } else if (c == CR) {
+    } else if (ch == CR) {
       // ignore this character, because LF will follow
 
-    } else if (c == LF) {
+    } else if (ch == LF) {
       // line is complete
-      break;
-
-    } else {
-      // add the character to the buffer
-      _readBuffer[index++] = c;
+      c->line[c->lineLen] = NUL;
+      c->lineLen = 0;
+      return (true);
 
+    } else if (c->lineLen < WEB_LINESIZE - 1) {
+      // add the character to the buffer.
       // When lines are too long, just ignore the last characters.
-      // If that happens in your application ther might be a header line that is out of interest
-      // or use a bigger line buffer by incrementing LINE_BUFFERSIZE.
-      if (index >= LINE_BUFFERSIZE) index = LINE_BUFFERSIZE - 1;
-
+      c->line[c->lineLen++] = ch;
     } // if
   } // while
-  _readBuffer[index] = NUL;
+  return (false);
 } // readRequestLine()
 
 
+/// Calculate the stamp of a file that is used in the ETag together with the file size.
+/// The stamp is the modification date and time of the file.
+/// The Arduino SD library has no function for this, so the directory entry of the file is searched
+/// in its folder and the FAT date and time of the last write are taken from there.
+uint32_t fileStamp(const char *path, File &f)
+{
+#if defined(ESP8266) || defined(ESP32)
+  (void)path;
+  return ((uint32_t)f.getLastWrite());
+#else
+  char entryName[11];
+  uint8_t entry[32];
+  uint32_t stamp = 0;
+
+  // the name in the directory entry: 8 + 3 chars filled with blanks.
+  memset(entryName, ' ', sizeof(entryName));
+  uint8_t n = 0;
+  for (const char *p = f.name(); (*p) && (n < sizeof(entryName)); p++) {
+    if (*p == '.') n = 8;
+    else entryName[n++] = toupper(*p);
+  }
+
+  // the folder of the file.
+  const char *p = strrchr(path, '/');
+  int len = (p && (p > path)) ? (p - path) : 0;
+  if (len >= LINE_BUFFERSIZE) return (0);
+  if (len > 0) memcpy(_readBuffer, path, len);
+  else _readBuffer[len++] = '/';
+  _readBuffer[len] = '\0';
+
+  // a directory is read as 32 byte entries.
+  File dir = SD.open(_readBuffer, O_READ);
+  if (dir) {
+    while (dir.read(entry, sizeof(entry)) == sizeof(entry)) {
+      if (entry[0] == 0x00) break;  // end of the directory
+      if ((entry[11] & 0x18) || (memcmp(entry, entryName, sizeof(entryName)) != 0)) continue;  // folder, volume or other name
+      // last write time at offset 22 and date at offset 24.
+      stamp = ((uint32_t)(entry[24] | (entry[25] << 8)) << 16) | (uint16_t)(entry[22] | (entry[23] << 8));
+      break;
+    } // while
+    dir.close();
+  } // if
+  return (stamp);
+#endif
+} // fileStamp()
+
+
+/// Append the ETag header for a file.
+void appendETag(StringBuffer &sout, uint32_t size, uint32_t stamp)
+{
+  char buf[1 + 2 * sizeof(uint32_t)];
+  sout.append("ETag: \"");
+  sout.append(ultoa(size, buf, 16));
+  sout.append('-');
+  sout.append(ultoa(stamp, buf, 16));
+  sout.append("\"\r\n");
+} // appendETag()
+
+
 /// Responds the content of a file from the SD disk given by fName.
+/// A pre-compressed version of the file is used when available and accepted by the client.
+/// The header is sent out immediately, the content is sent in chunks by the SEND_FILE state.
 void respondFileContent(const char *fName)
 {
   DEBUG_FUNC0("respondFileContent");
@@ -518,40 +663,71 @@ void respondFileContent(const char *fName)
 
   const char *p;
   const char *fileType = NULL;
-  size_t len;
+  bool gzip = false;
+  File f;
 
   // check for fileType
   p = strrchr(fName, '.');
   if (p != NULL) fileType = p + 1;
 
-  File f = SD.open(fName, O_READ);
+  char gzName[sizeof(GZIP_PREFIX) + sizeof(_conn->uri) + sizeof(GZIP_SUFFIX)];
+  if (_conn->acceptGzip) {
+    strcpy(gzName, GZIP_PREFIX);
+    strcat(gzName, fName);
+    strcat(gzName, GZIP_SUFFIX);
+    f = SD.open(gzName, O_READ);
+    if (f) gzip = true;
+  } // if
+
+  if (!f) f = SD.open(fName, O_READ);
+
   if (! f) {
     respond404NotFound();
 
   } else {
-    // respond the content type
-    p = _ctFind(CONTENTTYPES, fileType);
-    if (p) {
-      char ct[32];
-      p = _ctNextWord(p);
-      p = _ctCopyWord(p, ct, sizeof(ct));
-      sout.append(HTTP_200_CT); sout.append(ct); sout.append(CRLF);
-      sout.append(HTTP_GENERAL);
+    uint32_t size = f.size();
+    uint32_t stamp = fileStamp(gzip ? gzName : fName, f);
+
+    if ((_conn->hasETag) && (_conn->etagSize == size) && (_conn->etagStamp == stamp)) {
+      // the client has the current version of the file.
+      sout.append(HTTP_304);
+      appendGeneralHeader(sout, true);
+      appendETag(sout, size, stamp);
+      sout.append(HTTP_ENDHEAD);
+      _client.print(_writeBuffer);
+      f.close();
+      return;
+    } // if
+
+    // respond the content type directly from the table in PROGMEM
+    const ContentType *ct = findContentType(fileType);
+    if (ct) {
+      sout.append(HTTP_200_CT); sout.append((const __FlashStringHelper *)ct->type); sout.append(CRLF);
+    } else {
+      sout.append(HTTP_200);
     }
+    appendGeneralHeader(sout, true);
 
-    if (p) {
+    if (ct) {
+      char cache = pgm_read_byte(&ct->cache);
       sout.append("Cache-Control: ");
-      if (*p == '1') {
+      if (cache == '1') {
         sout.append("no-cache\r\n");
-      } else if (*p == 'C') {
+      } else if (cache == 'C') {
         sout.append("max-age=600, public\r\n");
       } else {
         sout.append("private\r\n");
       }
     } // if
 
+    if (gzip) {
+      sout.append("Content-Encoding: gzip\r\n");
+    } // if
+    sout.append("Vary: Accept-Encoding\r\n");
+    appendETag(sout, size, stamp);
+
     // respond the number of file bytes.
-    sout.append("Content-Length: "); sout.append(f.size()); sout.append(CRLF);
+    sout.append("Content-Length: "); sout.append(size); sout.append(CRLF);
 
     // end of headers: respond Blank Line.
     sout.append(HTTP_ENDHEAD);
@@ -559,199 +735,438 @@ void respondFileContent(const char *fName)
     // and send out buffer.
     _client.print(_writeBuffer);
 
-    // using a buffer is up to 10 times faster than transferring byte by byte
-    // using the _readBuffer
-    do {
-      len = f.read((uint8_t*)_readBuffer, LINE_BUFFERSIZE);
-      _client.write((uint8_t*)_readBuffer, len);
-    } while (len > 0);
-    f.close();
+    // the content is sent by the following loops.
+    _conn->file = f;
+    _conn->state = SEND_FILE;
   } // if
 
 } // respondFileContent()
 
 
-/// This is the main webserver routine.
-/// Constantly look for incomming webserver requests and answer them...
-void loopWebServer(unsigned long now) {
-  static unsigned long timeout;
+/// The root of the web server is requested, but this is not a file.
+/// So redirect if no file path was given.
+/// Because this is a complicated task there is a special file "redirect.htm" that contains all the stuff needed for this.
+void respondRedirect()
+{
+  respondFileContent(REDIRECT_FNAME);
+} // respondRedirect()
 
-  // static bool moreData = false;
-  const char *p;
 
-  File f;
+// ----- Route table -----
+// The routes for GET requests with a generated response.
+// Other requests are answered by the content of a file.
 
-  if (webstate != WEBSERVER_OFF) {
-    // Find a socket that has data available and return a client for this port.
-    // In the EthernetServer actually there is always a client with the port == MAX_SOCK_NUM returned but it has no data.
-    _client = server.available();
-
-    if (_client) {
-      // Answer this webserver request until done and then close the port.
-      while (_client.connected()) {
-        if (_client.available()) {
-          // Data is available...
-
-          if (webstate == WEBSERVER_IDLE) {
-            // Got a new request from a new client.
-            // Read a http header and parse all information.
-
-            // read the first line into the line buffer requestLine
-            readRequestLine();
-
-            // The requestLine consists of the method, the Request-URI and the HTTP-Version, all separated by SPACE characters.
-            // The SPACE chars are substituded by NUL chars and pointers are set to their part of the requestLine.
-            p = _readBuffer;
-            p = _ctCopyWord(p, _httpVerb, sizeof(_httpVerb)); // extract the verb
-            p = _ctCopyWord(p, _httpURI, sizeof(_httpURI)); // extract the URI
-            // we don't need the rest of the first line
-
-            // read following lines extracting some data (if there)
-            _httpContentLen = 0;
-            do {
-              readRequestLine();
-              if (memcmp(_readBuffer, "Content-Length: ", 16) == 0) {
-                _httpContentLen = atoi(_readBuffer + 16);
-              } // if
-            } while (_readBuffer[0] != NUL);
-
-            if (strcmp(_httpVerb, "GET") == 0) {
-              webstate = PROCESS_GET;
-            } else if (strcmp(_httpVerb, "PUT") == 0) {
-              webstate = PROCESS_PUT;
-            } else if (strcmp(_httpVerb, "POST") == 0) {
-              webstate = PROCESS_POST;
-            } else {
-              webstate = PROCESS_ERR;
-            } // if
-
-            // convert _httpURI to lowercase for we need no case here !
-            strlwr(_httpURI);
-
-            timeout = now + 1200;
-          } // webstate == idle
-
-
-          if (now > timeout) {
-            webstate = PROCESS_STOP;
-
-          } else if (webstate == PROCESS_GET) {
-            // ----- WebServer utitily functions - comment out if you don't need them
-
-            if (strcmp(_httpURI, "/$list") == 0) {
-              // List all files on the SD card
-              respondFileList();
-
-            } else if (strcmp(_httpURI, "/$info") == 0) {
-              // give some system information back.
-              respondSystemInfo();
-
-            } else if (strcmp(_httpURI, "/$radio") == 0) {
-              // respond the current radio data.
-              respondRadioData();
-
-            } else if (memcmp(_httpURI, "/", 1 + 1) == 0) {
-              // The root of the web server is requested, but this is not a file.
-              // So redirect if no file path was given.
-              // Because this is a complicated task there is a special file "redirect.htm" that contains all the stuff needed for this.
-              respondFileContent(REDIRECT_FNAME);
-
-            } else {
-              // ----- Respond the content of a file -----
-              respondFileContent(_httpURI);
-            } // if
-
-            // GET requests will never have a content so its all done.
-            webstate = PROCESS_STOP;
-
-          } else if (webstate == PROCESS_POST) {
-            // get data posted by a html form
-
-            uint16_t len;
-            len = _client.read((uint8_t *)_readBuffer, LINE_BUFFERSIZE);
-
-            if ((len > 0) && (len < sizeof(_readBuffer))) {
-              _httpContentLen -= len;
-              _readBuffer[len] = NUL; // _readBuffer[32] = NUL;
-            }
-
-            if (_httpContentLen == 0) {
-              respondEmptyFile();
-              webstate = PROCESS_STOP;
-            } // if
-
-            if (strcmp(_httpURI, "/$radio") == 0) {
-              const char *name = NULL; // name of command
-
-              // simple parsing of the JSON request.
-              // assume only one command like {"vol":6}
-              // DEBUG_STR(_readBuffer);
-              char *p = strchr(_readBuffer, '{');
-              if (p) p = strchr(p, '"');
-              if (p) p += 1;
-              if (p) {
-                name = p;
-                p = strchr(p, '"');
-              }
-              if (p) {
-                *p++ = NUL;
-                p = strchr(p, ':');
-              }
-              if (p) {
-                p += 1;
-                runRadioJSONCommand(name, atoi(p));
-              } // if
-
-            } // if
-
-          } else if (webstate == PROCESS_PUT) {
-            // upload a file
-            int len;
-            DEBUG_VAL("Upload...", _httpURI);
-
-            len = _client.read((uint8_t *)_readBuffer, 32);
-            if (len > 0) {
-              _readBuffer[len] = NUL; _readBuffer[32] = NUL;
-
-              if (!f) {
-                f = SD.open(_httpURI, O_CREAT | O_WRITE | O_TRUNC);
-                if (!f) {
-                  DEBUG_STR("no OPEN");
-                  webstate = PROCESS_ERR;
-                } // if
-              }  // if
-              f.write((uint8_t *)_readBuffer, len);
-              DEBUG_VAL("len", len);
-              _httpContentLen -= len;
-            } // if
-            // DEBUG_STR(_httpContentLen);
-
-            if (_httpContentLen == 0) {
-              f.close();
-              webstate = PROCESS_STOP;
-            }
-          } // PROCESS_PUT
-
-          if (webstate == PROCESS_ERR) {
-            // everything else is a 404
-            respond404NotFound();
-            webstate = PROCESS_STOP;
-          } // if
+/// Handler function for a route.
+typedef void (*WebHandler)();
+
+/// An entry in the table of routes.
+struct WebRoute {
+  char path[8];
+  WebHandler handler;
+};
+
+#define ROUTEHASH(path) webHash(path, WEBHASH_ROUTE_SLOTS, WEBHASH_ROUTE_SEED)
+
+// verify the slots of the route table
+static_assert(ROUTEHASH("/$radio") == 0, "route slot mismatch");
+static_assert(ROUTEHASH("/") == 1, "route slot mismatch");
+static_assert(ROUTEHASH("/$info") == 2, "route slot mismatch");
+static_assert(ROUTEHASH("/$list") == 4, "route slot mismatch");
+static_assert(ROUTEHASH("/$perf") == 6, "route slot mismatch");
+
+/// Table of routes, using a perfect hash of the path.
+/// WebServer utility functions can be removed if you don't need them
+const WebRoute webRoutes[WEBHASH_ROUTE_SLOTS] PROGMEM = {
+  { "/$radio", respondRadioData },   // 0: respond the current radio data.
+  { "/", respondRedirect },          // 1
+  { "/$info", respondSystemInfo },   // 2: give some system information back.
+  { "", NULL },                      // 3
+  { "/$list", respondFileList },     // 4: List all files on the SD card
+  { "", NULL },                      // 5
+  { "/$perf", respondPerfData },    // 6: timing of the loop functions.
+  { "", NULL }                       // 7
+};
+
+
+/// Find the handler for a path.
+/// Returns NULL when there is no route for the path.
+WebHandler findRoute(const char *path)
+{
+  const WebRoute *r = &webRoutes[ROUTEHASH(path)];
+  return ((strcmp_P(path, r->path) == 0) ? (WebHandler)pgm_read_ptr(&r->handler) : NULL);
+} // findRoute()
+
+
+#if defined(ARDUINO_ARCH_AVR)
+// Timer1 counts the cycles like in the BenchRDS example.
+// It overflows after 65536 cycles so every loop is measured by itself and an overflow is detected by the TOV1 flag.
+#define BENCH_START() \
+  noInterrupts(); \
+  TCNT1 = 0; \
+  TIFR1 = _BV(TOV1);
+
+#define BENCH_STOP(cycles) \
+  cycles += TCNT1; \
+  if (TIFR1 & _BV(TOV1)) cycles += 0x10000UL; \
+  interrupts();
+
+#elif defined(ESP8266) || defined(ESP32)
+#define BENCH_START() benchStart = ESP.getCycleCount();
+#define BENCH_STOP(cycles) cycles += ESP.getCycleCount() - benchStart;
+
+#else
+#define BENCH_START() benchStart = micros();
+#define BENCH_STOP(cycles) cycles += (micros() - benchStart) * (F_CPU / 1000000UL);
+#endif
+
+#define BENCH_LOOPS 200
+
+/// Measure the cycles used for dispatching requests by the route and content type tables.
+/// The hash lookup is compared to a linear scan over the same tables.
+void benchmarkDispatch()
+{
+  static const char *paths[] = { "/$radio", "/", "/$list", "/radio.htm" };
+  static const char *exts[] = { "htm", "js", "css", "png", "xyz" };
+  const uint8_t cnt = (sizeof(paths) / sizeof(paths[0])) + (sizeof(exts) / sizeof(exts[0]));
+  volatile const void *found;
+  unsigned long benchStart = 0;
+  unsigned long overhead = 0, hashCycles = 0, scanCycles = 0;
+  (void)benchStart;
+
+#if defined(ARDUINO_ARCH_AVR)
+  // use Timer1 without prescaler and restore it at the end.
+  uint8_t tccr1a = TCCR1A, tccr1b = TCCR1B, timsk1 = TIMSK1;
+  TCCR1A = 0;
+  TCCR1B = _BV(CS10);
+  TIMSK1 = 0;
+#endif
+
+  // the cycles of the measurement itself.
+  BENCH_START();
+  BENCH_STOP(overhead);
+
+  for (int n = 0; n < BENCH_LOOPS; n++) {
+    BENCH_START();
+    for (const char *p : paths) found = (const void *)findRoute(p);
+    for (const char *e : exts) found = findContentType(e);
+    BENCH_STOP(hashCycles);
+  }
+
+  for (int n = 0; n < BENCH_LOOPS; n++) {
+    BENCH_START();
+    for (const char *p : paths) {
+      found = NULL;
+      for (uint8_t i = 0; i < WEBHASH_ROUTE_SLOTS; i++) {
+        if (strcmp_P(p, webRoutes[i].path) == 0) { found = &webRoutes[i]; break; }
+      }
+    }
+    for (const char *e : exts) {
+      found = NULL;
+      for (uint8_t i = 0; i < WEBHASH_CT_SLOTS; i++) {
+        if (strcmp_P(e, contentTypes[i].ext) == 0) { found = &contentTypes[i]; break; }
+      }
+    }
+    BENCH_STOP(scanCycles);
+  }
+  (void)found;
+
+#if defined(ARDUINO_ARCH_AVR)
+  TCCR1A = tccr1a;
+  TCCR1B = tccr1b;
+  TIMSK1 = timsk1;
+#endif
 
+  hashCycles -= min(hashCycles, overhead * BENCH_LOOPS);
+  scanCycles -= min(scanCycles, overhead * BENCH_LOOPS);
+
+  Serial.print(F("dispatch cycles/lookup hash: "));
+  Serial.print(hashCycles / (BENCH_LOOPS * cnt));
+  Serial.print(F(" scan: "));
+  Serial.println(scanCycles / (BENCH_LOOPS * cnt));
+} // benchmarkDispatch()
+
+
+/// Simple parsing of the JSON request posted to $radio.
+/// assume only one command like {"vol":6}
+void processRadioPost(char *data)
+{
+  const char *name = NULL; // name of command
+
+  char *p = strchr(data, '{');
+  if (p) p = strchr(p, '"');
+  if (p) p += 1;
+  if (p) {
+    name = p;
+    p = strchr(p, '"');
+  }
+  if (p) {
+    *p++ = NUL;
+    p = strchr(p, ':');
+  }
+  if (p) {
+    p += 1;
+    runRadioJSONCommand(name, atoi(p));
+  } // if
+} // processRadioPost()
+
+
+/// Process a complete line from the request header.
+void processRequestLine(WebConnection *c, unsigned long now)
+{
+  const char *p;
+
+  if (c->state == WEBSERVER_IDLE) {
+    // Got a new request on this connection.
+    // Empty lines between pipelined requests are ignored.
+    if (c->line[0] == NUL) return;
+
+    // The requestLine consists of the method, the Request-URI and the HTTP-Version, all separated by SPACE characters.
+    p = c->line;
+    p = _ctCopyWord(p, c->verb, sizeof(c->verb)); // extract the verb
+    p = _ctCopyWord(p, c->uri, sizeof(c->uri));   // extract the URI
+
+    // HTTP/1.1 connections are persistent by default.
+    c->http11 = (strcmp(p, "HTTP/1.1") == 0);
+    c->keepAlive = c->http11;
+    c->acceptGzip = false;
+    c->hasETag = false;
+    c->contentLen = 0;
+    c->state = READ_HEADER;
+    c->timeout = now + WEBSERVER_TIMEOUT;
+
+  } else if (c->line[0] != NUL) {
+    // read following lines extracting some data (if there)
+    strlwr(c->line);
+    if (memcmp(c->line, "content-length:", 15) == 0) {
+      c->contentLen = atoi(c->line + 15);
+
+    } else if (memcmp(c->line, "connection:", 11) == 0) {
+      if (strstr(c->line, "close")) c->keepAlive = false;
+      if (strstr(c->line, "keep-alive")) c->keepAlive = true;
+
+    } else if (memcmp(c->line, "accept-encoding:", 16) == 0) {
+      c->acceptGzip = (strstr(c->line, "gzip") != NULL);
+
+    } else if (memcmp(c->line, "if-none-match:", 14) == 0) {
+      // only the first ETag of the format "size-stamp" is used.
+      char *e = strchr(c->line, '"');
+      if (e) {
+        c->etagSize = strtoul(e + 1, &e, 16);
+        if (*e == '-') {
+          c->etagStamp = strtoul(e + 1, &e, 16);
+          c->hasETag = (*e == '"');
         } // if
+      } // if
+    } // if
+
+  } else {
+    // empty line: end of the header.
+    if (strcmp(c->verb, "GET") == 0) {
+      c->state = PROCESS_GET;
+    } else if (strcmp(c->verb, "PUT") == 0) {
+      c->state = PROCESS_PUT;
+    } else if (strcmp(c->verb, "POST") == 0) {
+      c->state = PROCESS_POST;
+    } else {
+      // the end of an unknown request cannot be found.
+      c->keepAlive = false;
+      c->state = PROCESS_ERR;
+    } // if
+
+    // convert the URI to lowercase for we need no case here !
+    strlwr(c->uri);
+
+    // the content must make progress from now on.
+    c->timeout = now + WEBSERVER_TIMEOUT;
+  } // if
+} // processRequestLine()
+
+
+/// The response is complete. Wait for the next request or close the connection.
+void finishRequest(WebConnection *c, unsigned long now)
+{
+  if (c->keepAlive) {
+    c->state = WEBSERVER_IDLE;
+    c->lineLen = 0;
+    c->timeout = now + WEBSERVER_KEEPALIVE;
+  } else {
+    c->state = PROCESS_STOP;
+  } // if
+} // finishRequest()
+
+
+/// Process one step on a connection.
+/// Every step is short so other connections and the radio are not blocked by a slow client.
+void processConnection(WebConnection *c, unsigned long now)
+{
+  int len;
+
+  _conn = c;
+  _client = c->client;
+
+  if (!c->client.connected()) {
+    c->state = PROCESS_STOP;
+
+  } else if (((long)(now - c->timeout) > 0) && (c->state != PROCESS_STOP)) {
+    // no (complete) request in time or no progress on sending or receiving the content.
+    c->state = PROCESS_STOP;
+  } // if
+
+  // read the header lines as far as data is available
+  while (((c->state == WEBSERVER_IDLE) || (c->state == READ_HEADER)) && (readRequestLine(c))) {
+    processRequestLine(c, now);
+  } // while
+
+  if (c->state == PROCESS_GET) {
+    WebHandler handler = findRoute(c->uri);
+
+    if (handler) {
+      handler();
+
+    } else {
+      // ----- Respond the content of a file -----
+      respondFileContent(c->uri);
+    } // if
+
+    // GET requests will never have a content so its all done unless a file is sent.
+    if (c->state == PROCESS_GET) finishRequest(c, now);
+
+  } else if (c->state == SEND_FILE) {
+    // using a buffer is up to 10 times faster than transferring byte by byte
+    // using the _readBuffer
+    len = c->file.read((uint8_t *)_readBuffer, LINE_BUFFERSIZE);
+    if (len > 0) {
+      int sent = c->client.write((uint8_t *)_readBuffer, len);
+      if (sent > 0) c->timeout = now + WEBSERVER_TIMEOUT;
+      // the rest is sent again in the next step.
+      if (sent < len) c->file.seek(c->file.position() - (len - (sent > 0 ? sent : 0)));
+    } else {
+      c->file.close();
+      finishRequest(c, now);
+    } // if
+
+  } else if (c->state == PROCESS_POST) {
+    // get data posted by a html form.
+    // Read exactly the content so a pipelined request stays in the socket.
+    while ((c->contentLen > 0) && (c->client.available())) {
+      int ch = c->client.read();
+      if (ch < 0) break;
+      if (c->lineLen < WEB_LINESIZE - 1) c->line[c->lineLen++] = ch;
+      c->contentLen--;
+      c->timeout = now + WEBSERVER_TIMEOUT;
+    } // while
+
+    if (c->contentLen <= 0) {
+      c->line[c->lineLen] = NUL;
+      c->lineLen = 0;
+
+      if (strcmp(c->uri, "/$radio") == 0) {
+        processRadioPost(c->line);
+      } // if
+      respondEmptyFile();
+      finishRequest(c, now);
+    } // if
+
+  } else if (c->state == PROCESS_PUT) {
+    // upload a file
+    if (!c->file) {
+      DEBUG_VAL("Upload...", c->uri);
+      c->file = SD.open(c->uri, O_CREAT | O_WRITE | O_TRUNC);
+      if (!c->file) {
+        DEBUG_STR("no OPEN");
+        c->keepAlive = false;
+        c->state = PROCESS_ERR;
+      } // if
+    } // if
 
-        if (webstate == PROCESS_STOP) {
-          // DEBUG_STR("PROCESS_STOP");
-          _client.stop();
-          webstate = WEBSERVER_IDLE;
+    if (c->state == PROCESS_PUT) {
+      len = c->client.available();
+      if (len > c->contentLen) len = c->contentLen;
+      if (len > LINE_BUFFERSIZE) len = LINE_BUFFERSIZE;
+
+      if (len > 0) {
+        len = c->client.read((uint8_t *)_readBuffer, len);
+        if (len > 0) {
+          c->file.write((uint8_t *)_readBuffer, len);
+          DEBUG_VAL("len", len);
+          c->contentLen -= len;
+          c->timeout = now + WEBSERVER_TIMEOUT;
         } // if
+      } // if
+
+      if (c->contentLen <= 0) {
+        c->file.close();
+        respondEmptyFile();
+        finishRequest(c, now);
+      } // if
+    } // if
+  } // PROCESS_PUT
+
+  if (c->state == PROCESS_ERR) {
+    // everything else is a 404
+    respond404NotFound();
+    finishRequest(c, now);
+  } // if
+
+  if (c->state == PROCESS_STOP) {
+    // DEBUG_STR("PROCESS_STOP");
+    if (c->file) c->file.close();
+    c->client.stop();
+    c->state = WEBSERVER_OFF;
+  } // if
+} // processConnection()
+
+
+/// Find a connection for a new client.
+/// When all are in use an idle keep-alive connection is closed.
+WebConnection *findConnection()
+{
+  WebConnection *idle = NULL;
+
+  for (uint8_t n = 0; n < WEBSERVER_CONNECTIONS; n++) {
+    WebConnection *c = &_connections[n];
+    if (c->state == WEBSERVER_OFF) {
+      return (c);
+    } else if ((c->state == WEBSERVER_IDLE) && (c->lineLen == 0) && (!c->client.available())) {
+      if ((!idle) || ((long)(c->timeout - idle->timeout) < 0)) idle = c;
+    } // if
+  } // for
+
+  if (idle) {
+    idle->client.stop();
+    idle->state = WEBSERVER_OFF;
+  } // if
+  return (idle);
+} // findConnection()
 
-        // give the web browser time to receive the data
-        delay(1);
-      } // while
 
+/// This is the main webserver routine.
+/// Constantly look for incomming webserver requests and answer them...
+/// All open connections are served one step in a round-robin order.
+void loopWebServer(unsigned long now) {
+  if (webstate != WEBSERVER_OFF) {
+    // accept a new connection
+    EthernetClient newClient = server.accept();
+
+    if (newClient) {
+      WebConnection *c = findConnection();
+      if (c) {
+        c->client = newClient;
+        c->state = WEBSERVER_IDLE;
+        c->lineLen = 0;
+        c->timeout = now + WEBSERVER_TIMEOUT;
+      } else {
+        newClient.stop();
+      } // if
     } // if
 
+    // process all open connections, starting with another one each time.
+    for (uint8_t n = 0; n < WEBSERVER_CONNECTIONS; n++) {
+      WebConnection *c = &_connections[(_nextConnection + n) % WEBSERVER_CONNECTIONS];
+      if (c->state != WEBSERVER_OFF) processConnection(c, now);
+    } // for
+    _nextConnection = (_nextConnection + 1) % WEBSERVER_CONNECTIONS;
+
     Ethernet.maintain();
   }
 
@@ -843,21 +1258,21 @@ void DisplaySoftMute(uint8_t v)
 
 /// Response to a $info request and return all information of the current radio operation.
 /// Format al data as in JSON Format.\n
+/// The data is streamed to the client in chunks so the size is not limited by the buffer.
 void respondRadioData()
 {
   // DEBUG_FUNC0("respondRadioData");
-  StringBuffer sout = StringBuffer(_writeBuffer, sizeof(_writeBuffer));
+  StringBuffer sout = StringBuffer(_writeBuffer, sizeof(_writeBuffer), &_client);
 
   // build http header in _writeBuffer and send out.
   sout.append(HTTP_200);
   sout.append(HTTP_CT); sout.append("application/json"); sout.append(CRLF);
-  sout.append(HTTP_GENERAL);
+  appendChunkedHeader(sout);
   sout.append(HTTP_NOCACHE);
   sout.append(HTTP_ENDHEAD);
-  _client.print(_writeBuffer);
+  sout.setChunked(_conn->http11);
 
   // JSON Data
-  sout.clear();
   sout.append('{');
 
   // return frequency
@@ -871,9 +1286,10 @@ void respondRadioData()
   sout.appendJSON("stereo", ri.stereo); sout.append(',');
   // respondJSONObject("rds", ri.rds); sout.append(',');      // has rds signal
 
-  // return rds information
+  // return rds information, the strings are escaped.
   sout.appendJSON("servicename", rdsServiceName); sout.append(',');
   sout.appendJSON("rdstext", rdsText); sout.append(',');
+  sout.appendJSON("rdstime", rdsTime); sout.append(',');
 
   // return audio related features
   AUDIO_INFO ai;
@@ -882,22 +1298,40 @@ void respondRadioData()
   sout.appendJSON("vol", ai.volume); sout.append(',');
   sout.appendJSON("mute", ai.mute); sout.append(',');
   sout.appendJSON("softmute", ai.softmute); sout.append(',');
-  sout.appendJSON("bassboost", ai.bassBoost);
+  sout.appendJSON("bassboost", ai.bassBoost); sout.append(',');
+
+  // return the list of preset stations
+  sout.append("\"presets\":[");
+  for (uint8_t n = 0; n < sizeof(preset) / sizeof(RADIO_FREQ); n++) {
+    if (n > 0) sout.append(',');
+    sout.append((int)preset[n]);
+  }
+  sout.append(']');
 
   sout.append('}');
-  _client.print(_writeBuffer);
+  sout.end();
 } // respondRadioData()
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-/// retrieve RDS data from the radio chip and forward to the RDS decoder library
-void RDS_process(uint16_t block1, uint16_t block2, uint16_t block3, uint16_t block4) {
+/// Tag the recorded groups with the current frequency, called after tuning and seeking.
+void recordFrequency() {
+  if (recording) rdsLog.setFrequency(millis(), radio.getFrequency(), radio.getBand());
+} // recordFrequency()
+
+
+/// retrieve RDS data from the radio chip, record it and forward to the RDS decoder library
+void RDS_process(uint16_t block1, uint16_t block2, uint16_t block3, uint16_t block4, uint8_t errors) {
   static uint16_t b1;
 
-  if (b1 != block1)
+  if (b1 != block1) {
     Serial.println(block1);
+    // a new station, also a seek that ended after the call returned.
+    recordFrequency();
+  }
   b1 = block1;
-  rds.processData(block1, block2, block3, block4);
+  if (recording) rdsLog.addGroup(millis(), block1, block2, block3, block4, errors);
+  rds.processData(block1, block2, block3, block4, errors);
 }
 
 
@@ -942,6 +1376,7 @@ void doMenuClick() {
 void doSeekClick() {
   Serial.println("SEEK...");
   radio.seekUp(true);
+  recordFrequency();
 } // doSeekClick()
 
 
@@ -992,7 +1427,7 @@ void setupRadio() {
   // setup the information chain for RDS data.
   *rdsServiceName = NUL;
   /// retrieve RDS data from the radio chip and forward to the RDS decoder library
-  radio.attachReceiveRDS(RDS_process); // or (rds.processData)
+  radio.attachReceiveRDSExt(RDS_process);
 
   rds.attachServiceNameCallback(DisplayServiceName);
   rds.attachTextCallback(DisplayText);
@@ -1015,6 +1450,7 @@ void loopRadio() {
 void runRadioJSONCommand(const char *cmd, int16_t value) {
   if (strcmp(cmd, "freq") == 0) {
     radio.setFrequency(value);
+    recordFrequency();
   } else if (strcmp(cmd, "vol") == 0) {
     radio.setVolume(value);
   } else if (strcmp(cmd, "mute") == 0) {
@@ -1028,6 +1464,11 @@ void runRadioJSONCommand(const char *cmd, int16_t value) {
 
   } else if (strcmp(cmd, "seekup") == 0) {
     radio.seekUp(true);
+    recordFrequency();
+
+  } else if (strcmp(cmd, "rec") == 0) {
+    if (value > 0) startRecording();
+    else stopRecording();
 
   } // if
 } // runRadioJSONCommand()
@@ -1096,6 +1537,9 @@ void runRadioSerialCommand(char cmd, int16_t value)
     Serial.println("b bass boost");
     Serial.println("m mute/unmute");
     Serial.println("u soft mute/unmute");
+    Serial.println("w web dispatch benchmark");
+    Serial.println("r record RDS groups to the SD card on/off");
+    Serial.println("p print and reset the timing of the loop functions");
   } // runRadioSerialCommand()
 
   // ----- control the volume and audio output -----
@@ -1121,16 +1565,19 @@ void runRadioSerialCommand(char cmd, int16_t value)
     // next preset
     if (presetIndex < (sizeof(preset) / sizeof(RADIO_FREQ)) - 1) {
       presetIndex++; radio.setFrequency(preset[presetIndex]);
+      recordFrequency();
     } // if
   } else if (cmd == '<') {
     // previous preset
     if (presetIndex > 0) {
       presetIndex--;
       radio.setFrequency(preset[presetIndex]);
+      recordFrequency();
     } // if
 
   } else if (cmd == 'f') {
     radio.setFrequency(value);
+    recordFrequency();
   } else if (cmd == 'v') {
     radio.setVolume(value);
   } else if (cmd == 'm') {
@@ -1140,12 +1587,16 @@ void runRadioSerialCommand(char cmd, int16_t value)
 
   else if (cmd == '.') {
     radio.seekUp(false);
+    recordFrequency();
   } else if (cmd == ':') {
     radio.seekUp(true);
+    recordFrequency();
   } else if (cmd == ',') {
     radio.seekDown(false);
+    recordFrequency();
   } else if (cmd == ';') {
     radio.seekDown(true);
+    recordFrequency();
   }
 
 
@@ -1170,6 +1621,22 @@ void runRadioSerialCommand(char cmd, int16_t value)
     radio.debugStatus();
   }
 
+  else if (cmd == 'w') {
+    benchmarkDispatch();
+  }
+
+  else if (cmd == 'r') {
+    if (recording) stopRecording();
+    else startRecording();
+  }
+
+  else if (cmd == 'p') {
+    profiler.print(Serial);
+    Serial.print("cost in nsec:");
+    Serial.println(RadioProfiler::getCost());
+    profiler.requestReset();  // after the measurement of this command.
+  }
+
 
 } // runRadioSerialCommand()
 
@@ -1195,6 +1662,7 @@ void loopButtons(unsigned long now) {
     if (rot_state == STATE_FREQ) {
       RADIO_FREQ f = radio.getMinFrequency() + (newPos *  radio.getFrequencyStep());
       radio.setFrequency(f);
+      recordFrequency();
       encoderLastPos = newPos;
       nextFreqTime = now + 10;
 
@@ -1235,6 +1703,62 @@ void loopButtons(unsigned long now) {
 } // loopButtons
 
 
+/// ----- Recording RDS groups -----
+
+/// Start recording by appending a new log to the file.
+void startRecording() {
+  if (recording) return;
+  recordFile = SD.open(RECORD_FNAME, FILE_WRITE);
+  if (recordFile) {
+    rdsLog.begin(millis(), "WebRadio");
+    rdsLog.setFrequency(millis(), radio.getFrequency(), radio.getBand());
+    recordSectors = 0;
+    recording = true;
+  }
+  DEBUG_VAL(F("Recording"), recording);
+} // startRecording()
+
+
+/// Write the remaining sectors and close the file.
+void stopRecording() {
+  if (!recording) return;
+  recording = false;
+  rdsLog.flush();
+  while (rdsLog.getSector()) {
+    recordFile.write(rdsLog.getSector(), RDSLOG_SECTORSIZE);
+    rdsLog.releaseSector();
+    recordSectors++;
+  }
+  recordFile.close();
+  DEBUG_VAL(F("Recorded sectors"), recordSectors);
+} // stopRecording()
+
+
+/// Return true when a web request is processed.
+bool webBusy() {
+  for (uint8_t n = 0; n < WEBSERVER_CONNECTIONS; n++) {
+    WebServerState s = _connections[n].state;
+    if ((s != WEBSERVER_OFF) && (s != WEBSERVER_IDLE)) return (true);
+  }
+  return (false);
+} // webBusy()
+
+
+/// Write at most one full sector in every loop.
+/// The write is delayed while a web request is active until only one buffer is left for new groups.
+void loopRecorder(unsigned long now) {
+  const uint8_t *sector = rdsLog.getSector();
+  (void)now;
+
+  if ((sector) && ((!webBusy()) || (rdsLog.getPending() >= RDSLOG_BUFFERS - 1))) {
+    recordFile.write(sector, RDSLOG_SECTORSIZE);
+    rdsLog.releaseSector();
+    recordSectors++;
+    if (recordSectors % RECORD_SYNC == 0) recordFile.flush();
+  } // if
+} // loopRecorder()
+
+
 void dumpCard() {
   DEBUG_FUNC0("dumpCard");
 
@@ -1302,19 +1826,22 @@ void setup() {
   }
   DEBUG_VAL(F("Free RAM"), FreeRam());
 
+  profiler.setBudget(PERF_BUDGET);
   lcd.clear();
 } // setup()
 
 
 /// Constantly look for the things, that have to be done.
+/// Every function is measured as a section of the profiler.
 void loop()
 {
   unsigned long now = millis();
-  loopWebServer(now);  /// Look for incoming webserver requests and answer them...
-  loopButtons(now);    /// Check for changed signals on the buttons and rotary encoder.
-  loopSerial();     /// Check for serial input commands and trigger command execution.
-  loopRadio();      /// Check for new radio data.
-  loopLCD(now);        /// Check for new LCD data to be displayed.
+  { RADIOPROFILE(profiler, PERF_WEB);  loopWebServer(now); }  /// Look for incoming webserver requests and answer them...
+  { RADIOPROFILE(profiler, PERF_BUTTONS);  loopButtons(now); }  /// Check for changed signals on the buttons and rotary encoder.
+  { RADIOPROFILE(profiler, PERF_SERIAL);  loopSerial(); }  /// Check for serial input commands and trigger command execution.
+  { RADIOPROFILE(profiler, PERF_RADIO);  loopRadio(); }  /// Check for new radio data.
+  if (recording) { RADIOPROFILE(profiler, PERF_RECORDER);  loopRecorder(now); } /// Write recorded RDS groups to the SD card.
+  { RADIOPROFILE(profiler, PERF_LCD);  loopLCD(now); }  /// Check for new LCD data to be displayed.
 } // loop()
 
 
@@ -0,0 +1,79 @@
+
+// WebTables.h contains the tables for looking up the content types of files
+// using a perfect hash function that is calculated at compile time.
+//
+// The hash of a key selects the slot in a table with a size of a power of 2.
+// The seed of a table is chosen so that all keys map to different slots.
+// When adding entries use a free slot and verify the slot by a static_assert.
+// If the new key collides, search for another seed and rearrange the table.
+
+#define WEBHASH_CT_SEED 24    ///< seed of the content type hash.
+#define WEBHASH_CT_SLOTS 16   ///< number of slots in the content type table.
+
+#define WEBHASH_ROUTE_SEED 15  ///< seed of the route hash.
+#define WEBHASH_ROUTE_SLOTS 8  ///< number of slots in the route table.
+
+/// Hash function for short keys, usable at compile time and at runtime.
+/// \param s The key.
+/// \param slots The number of slots in the table, must be a power of 2.
+/// \param h The seed of the table.
+constexpr uint8_t webHash(const char *s, uint8_t slots, uint16_t h)
+{
+  return ((*s) ? webHash(s + 1, slots, (uint16_t)((h * 33u) ^ (uint8_t)*s))
+               : (uint8_t)((h ^ (h >> 8)) & (slots - 1)));
+} // webHash()
+
+
+/// An entry in the table of content types.
+struct ContentType {
+  char ext[5];    ///< file extension, lowercase.
+  char type[25];  ///< content type
+  char cache;     ///< '1': no-cache, 'C': cached for 10 min. else private.
+};
+
+#define CTHASH(ext) webHash(ext, WEBHASH_CT_SLOTS, WEBHASH_CT_SEED)
+
+// verify the slots of the content type table
+static_assert(CTHASH("js") == 0, "content type slot mismatch");
+static_assert(CTHASH("png") == 1, "content type slot mismatch");
+static_assert(CTHASH("svg") == 2, "content type slot mismatch");
+static_assert(CTHASH("txt") == 3, "content type slot mismatch");
+static_assert(CTHASH("jsn") == 6, "content type slot mismatch");
+static_assert(CTHASH("htm") == 8, "content type slot mismatch");
+static_assert(CTHASH("gif") == 9, "content type slot mismatch");
+static_assert(CTHASH("html") == 10, "content type slot mismatch");
+static_assert(CTHASH("json") == 11, "content type slot mismatch");
+static_assert(CTHASH("css") == 12, "content type slot mismatch");
+static_assert(CTHASH("ico") == 13, "content type slot mismatch");
+static_assert(CTHASH("jpg") == 15, "content type slot mismatch");
+
+/// Table of file extension -> content-type and cache-control
+const ContentType contentTypes[WEBHASH_CT_SLOTS] PROGMEM = {
+  { "js", "application/x-javascript", '1' },  // 0
+  { "png", "image/png", 'C' },                // 1
+  { "svg", "image/svg+xml", 'C' },            // 2
+  { "txt", "text/txt", '0' },                 // 3
+  { "", "", 0 },                              // 4
+  { "", "", 0 },                              // 5
+  { "jsn", "application/json", 'C' },         // 6
+  { "", "", 0 },                              // 7
+  { "htm", "text/html", '1' },                // 8
+  { "gif", "image/gif", 'C' },                // 9
+  { "html", "text/html", '1' },               // 10
+  { "json", "application/json", 'C' },        // 11
+  { "css", "text/css", '1' },                 // 12
+  { "ico", "image/x-icon", '1' },             // 13
+  { "", "", 0 },                              // 14
+  { "jpg", "image/jpeg", '1' }                // 15
+};
+
+
+/// Find the content type entry for a file extension.
+/// Returns a pointer to the entry in PROGMEM or NULL.
+const ContentType *findContentType(const char *ext)
+{
+  if ((!ext) || (!*ext)) return (NULL);
+  const ContentType *ct = &contentTypes[CTHASH(ext)];
+  return ((strcmp_P(ext, ct->ext) == 0) ? ct : NULL);
+} // findContentType()
+
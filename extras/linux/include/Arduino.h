@@ -0,0 +1,161 @@
+///
+/// \file Arduino.h
+/// \brief Minimal Arduino API for compiling the radio libraries on Linux.
+///
+/// \author Matthias Hertel, http://www.mathertel.de
+/// \copyright Copyright (c) by Matthias Hertel.\n
+/// This work is licensed under a BSD 3-Clause license.\n
+/// See http://www.mathertel.de/License.aspx
+///
+/// \details
+/// Only the functions used by the radio chip libraries are implemented.
+/// The Serial output is written to stdout, pins and interrupts are ignored.
+/// The i2c bus is available by the RadioBus implementations in extras/linux/src.
+///
+/// History:
+/// --------
+/// * 18.10.2026 created.
+/// * 18.10.2026 simulated time for host simulations.
+
+#ifndef __LINUX_ARDUINO_H__
+#define __LINUX_ARDUINO_H__
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <type_traits>
+
+typedef uint8_t byte;
+typedef bool boolean;
+typedef uint16_t word;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+
+#define BIN 2
+#define DEC 10
+#define HEX 16
+
+#define PROGMEM
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+#define pgm_read_word(p) (*(const uint16_t *)(p))
+#define pgm_read_ptr(p) (*(void *const *)(p))
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper *>(s))
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+template <class A, class B>
+inline typename std::common_type<A, B>::type min(A a, B b) { return ((b < a) ? b : a); }
+
+template <class A, class B>
+inline typename std::common_type<A, B>::type max(A a, B b) { return ((a < b) ? b : a); }
+
+
+// ----- time -----
+// Host simulations can switch to a simulated time by setting _linuxSimulated.
+// The time then only advances by delay(), delayMicroseconds() and changing _linuxSimTime.
+
+extern bool _linuxSimulated;   ///< use the simulated time.
+extern uint64_t _linuxSimTime; ///< simulated time in micros.
+
+inline uint64_t _linuxMicros() {
+  if (_linuxSimulated) return (_linuxSimTime);
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000);
+}
+
+inline unsigned long micros() { return ((unsigned long)_linuxMicros()); }
+inline unsigned long millis() { return ((unsigned long)(_linuxMicros() / 1000)); }
+
+inline void delayMicroseconds(unsigned int us) {
+  if (_linuxSimulated) {
+    _linuxSimTime += us;
+    return;
+  }
+  struct timespec ts = { (time_t)(us / 1000000), (long)(us % 1000000) * 1000 };
+  nanosleep(&ts, nullptr);
+}
+
+inline void delay(unsigned long ms) {
+  if (_linuxSimulated) {
+    _linuxSimTime += (uint64_t)ms * 1000;
+    return;
+  }
+  struct timespec ts = { (time_t)(ms / 1000), (long)(ms % 1000) * 1000000 };
+  nanosleep(&ts, nullptr);
+}
+
+inline void yield() {}
+
+
+// ----- pins and interrupts are not available -----
+
+inline void pinMode(int, int) {}
+inline void digitalWrite(int, int) {}
+inline int digitalRead(int) { return (LOW); }
+inline void noInterrupts() {}
+inline void interrupts() {}
+
+
+// ----- Stream interface for RadioFrames -----
+
+class Stream {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual size_t write(const uint8_t *buffer, size_t size) = 0;
+};
+
+
+// ----- Serial output to stdout -----
+
+class LinuxSerial {
+public:
+  void begin(unsigned long) {}
+
+  size_t write(uint8_t c) { return (fputc(c, stdout) == EOF ? 0 : 1); }
+
+  size_t print(const char *s) { return (fputs(s, stdout) >= 0 ? strlen(s) : 0); }
+  size_t print(const __FlashStringHelper *s) { return (print(reinterpret_cast<const char *>(s))); }
+  size_t print(char c) { return (write(c)); }
+  size_t print(unsigned char n, int base = DEC) { return (print((unsigned long)n, base)); }
+  size_t print(int n, int base = DEC) { return (print((long)n, base)); }
+  size_t print(unsigned int n, int base = DEC) { return (print((unsigned long)n, base)); }
+  size_t print(long n, int base = DEC) {
+    if ((base == DEC) && (n < 0)) return (print('-') + print((unsigned long)-n, base));
+    return (print((unsigned long)n, base));
+  }
+  size_t print(unsigned long n, int base = DEC) {
+    char buf[8 * sizeof(long) + 1];
+    char *s = &buf[sizeof(buf) - 1];
+    *s = '\0';
+    if ((base < 2) || (base > 16)) base = DEC;
+    do {
+      *--s = "0123456789ABCDEF"[n % base];
+      n /= base;
+    } while (n);
+    return (print(s));
+  }
+  size_t print(double n, int digits = 2) { return (printf("%.*f", digits, n)); }
+
+  size_t println() { return (print('\n')); }
+  template <class T>
+  size_t println(T v) { return (print(v) + println()); }
+  template <class T>
+  size_t println(T v, int base) { return (print(v, base) + println()); }
+
+  void flush() { fflush(stdout); }
+};
+
+extern LinuxSerial Serial;
+
+#endif  // __LINUX_ARDUINO_H__
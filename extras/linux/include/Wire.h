@@ -0,0 +1,18 @@
+///
+/// \file Wire.h
+/// \brief Placeholder for the Arduino Wire library on Linux.
+///
+/// \details
+/// The radio libraries include Wire.h but on Linux the i2c bus is used through
+/// a RadioBus implementation like RadioLinuxBus or RadioFakeBus and radio.initBus().
+///
+/// History:
+/// --------
+/// * 18.10.2026 created.
+
+#ifndef __LINUX_WIRE_H__
+#define __LINUX_WIRE_H__
+
+#include <Arduino.h>
+
+#endif  // __LINUX_WIRE_H__
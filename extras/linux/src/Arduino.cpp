@@ -0,0 +1,15 @@
+///
+/// \file Arduino.cpp
+/// \brief Minimal Arduino runtime for building the radio libraries on Linux.
+///
+/// History:
+/// --------
+/// * 18.10.2026 created.
+/// * 18.10.2026 simulated time.
+
+#include <Arduino.h>
+
+LinuxSerial Serial;
+
+bool _linuxSimulated = false;
+uint64_t _linuxSimTime = 0;
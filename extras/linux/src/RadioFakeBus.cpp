@@ -0,0 +1,78 @@
+///
+/// \file RadioFakeBus.cpp
+/// \brief In-process i2c bus for running the radio libraries without hardware.
+///
+/// \author Matthias Hertel, http://www.mathertel.de
+/// \copyright Copyright (c) by Matthias Hertel.\n
+/// This work is licensed under a BSD 3-Clause license.\n
+/// See http://www.mathertel.de/License.aspx
+///
+/// \details
+/// See RadioFakeBus.h for the usage.
+///
+/// History:
+/// --------
+/// * 18.10.2026 created.
+
+#include "RadioFakeBus.h"
+
+
+RadioFakeBus::RadioFakeBus() {
+  memset(_devices, 0, sizeof(_devices));
+}  // RadioFakeBus()
+
+
+bool RadioFakeBus::addDevice(uint8_t address) {
+  if (_find(address)) return (true);
+  if (_count >= RADIOFAKEBUS_DEVICES) return (false);
+  _devices[_count++].address = address;
+  return (true);
+}  // addDevice()
+
+
+uint8_t *RadioFakeBus::getMemory(uint8_t address) {
+  Device *d = _find(address);
+  return (d ? d->memory : nullptr);
+}  // getMemory()
+
+
+int RadioFakeBus::transfer(uint8_t address, const uint8_t *cmdData, int cmdLen, uint8_t *data, int len) {
+  transfers++;
+  bytesWritten += cmdLen;
+  bytes += cmdLen;
+
+  if (_handler) {
+    int res = _handler(address, cmdData, cmdLen, data, len);
+    if (res > 0) bytesRead += res;
+    if (res > 0) bytes += res;
+    return (res);
+  }
+
+  Device *d = _find(address);
+  if (!d) return (-1);
+
+  if (cmdLen > 0) {
+    d->pointer = cmdData[0];
+    for (int i = 1; i < cmdLen; i++) {
+      d->memory[d->pointer++] = cmdData[i];
+    }
+  }
+
+  if ((data) && (len > 0)) {
+    for (int i = 0; i < len; i++) {
+      data[i] = d->memory[d->pointer++];
+    }
+    bytesRead += len;
+    bytes += len;
+    return (len);
+  }
+  return (0);
+}  // transfer()
+
+
+RadioFakeBus::Device *RadioFakeBus::_find(uint8_t address) {
+  for (uint8_t n = 0; n < _count; n++) {
+    if (_devices[n].address == address) return (&_devices[n]);
+  }
+  return (nullptr);
+}  // _find()
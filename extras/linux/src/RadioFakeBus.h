@@ -0,0 +1,66 @@
+///
+/// \file RadioFakeBus.h
+/// \brief In-process i2c bus for running the radio libraries without hardware.
+///
+/// \author Matthias Hertel, http://www.mathertel.de
+/// \copyright Copyright (c) by Matthias Hertel.\n
+/// This work is licensed under a BSD 3-Clause license.\n
+/// See http://www.mathertel.de/License.aspx
+///
+/// \details
+/// Devices are added by their address and simulated by a memory of 256 bytes and a pointer,
+/// similar to the i2c-stub module of Linux:
+/// The first written byte sets the pointer and the following bytes are stored from there,
+/// reading starts at the pointer. The pointer is incremented after every byte.
+///
+/// A handler function can be attached to simulate the protocol of a specific chip.
+///
+/// History:
+/// --------
+/// * 18.10.2026 created.
+
+#ifndef __RADIOFAKEBUS_H__
+#define __RADIOFAKEBUS_H__
+
+#include <radio.h>
+
+#define RADIOFAKEBUS_DEVICES 4  ///< max. number of simulated devices.
+
+/// callback function for simulating a chip, returns the number of bytes read or -1.
+typedef int (*RadioFakeHandler)(uint8_t address, const uint8_t *cmdData, int cmdLen, uint8_t *data, int len);
+
+/// i2c bus with simulated devices.
+class RadioFakeBus : public RadioBus {
+public:
+  RadioFakeBus();
+
+  /// Add a simulated device.
+  /// \return false when there is no more space for a device.
+  bool addDevice(uint8_t address);
+
+  /// Access the memory of a simulated device.
+  uint8_t *getMemory(uint8_t address);
+
+  /// Use a handler instead of the memories for all transfers.
+  void attachHandler(RadioFakeHandler handler) { _handler = handler; };
+
+  int transfer(uint8_t address, const uint8_t *cmdData, int cmdLen, uint8_t *data, int len) override;
+
+  uint32_t bytesWritten = 0;  ///< number of bytes written to all devices.
+  uint32_t bytesRead = 0;     ///< number of bytes read from all devices.
+
+private:
+  struct Device {
+    uint8_t address;
+    uint8_t pointer;
+    uint8_t memory[256];
+  };
+
+  Device _devices[RADIOFAKEBUS_DEVICES];
+  uint8_t _count = 0;
+  RadioFakeHandler _handler = nullptr;
+
+  Device *_find(uint8_t address);
+};  // RadioFakeBus
+
+#endif  // __RADIOFAKEBUS_H__
@@ -0,0 +1,164 @@
+///
+/// \file RadioLinuxBus.cpp
+/// \brief i2c bus implementation for Linux using the i2c-dev interface.
+///
+/// \author Matthias Hertel, http://www.mathertel.de
+/// \copyright Copyright (c) by Matthias Hertel.\n
+/// This work is licensed under a BSD 3-Clause license.\n
+/// See http://www.mathertel.de/License.aspx
+///
+/// \details
+/// See RadioLinuxBus.h for the usage.
+///
+/// History:
+/// --------
+/// * 18.10.2026 created.
+
+#include "RadioLinuxBus.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+#define SMBUS_BLOCKMAX 32  // max. data in one SMBus block transfer
+
+
+RadioLinuxBus::RadioLinuxBus(const char *device) {
+  _device = device;
+}  // RadioLinuxBus()
+
+
+RadioLinuxBus::~RadioLinuxBus() {
+  end();
+}  // ~RadioLinuxBus()
+
+
+bool RadioLinuxBus::begin() {
+  unsigned long funcs = 0;
+
+  if (_fd < 0) {
+    _fd = open(_device, O_RDWR);
+    if (_fd < 0) return (false);
+
+    // use combined transfers when the adapter supports them.
+    if (ioctl(_fd, I2C_FUNCS, &funcs) == 0) {
+      _combined = (funcs & I2C_FUNC_I2C);
+    }
+    _address = -1;
+  }
+  return (true);
+}  // begin()
+
+
+void RadioLinuxBus::end() {
+  if (_fd >= 0) {
+    close(_fd);
+    _fd = -1;
+  }
+}  // end()
+
+
+int RadioLinuxBus::transfer(uint8_t address, const uint8_t *cmdData, int cmdLen, uint8_t *data, int len) {
+  struct i2c_msg msgs[2];
+  struct i2c_rdwr_ioctl_data rdwr;
+  int n = 0;
+
+  if (_fd < 0) return (-1);
+  transfers++;
+
+  if ((!_combined) || ((cmdLen == 0) && (len == 0))) {
+    // SMBus commands and the device check by a SMBus quick command, some adapters refuse I2C_RDWR without data.
+    int res = _smbusTransfer(address, cmdData, cmdLen, data, len);
+    if (res >= 0) bytes += cmdLen + res;
+    return (res);
+  }
+
+  if (cmdLen > 0) {
+    // the write message.
+    msgs[n].addr = address;
+    msgs[n].flags = 0;
+    msgs[n].len = cmdLen;
+    msgs[n].buf = const_cast<uint8_t *>(cmdData);
+    n++;
+  }
+
+  if ((data) && (len > 0)) {
+    // the read message, sent after a repeated start.
+    msgs[n].addr = address;
+    msgs[n].flags = I2C_M_RD;
+    msgs[n].len = len;
+    msgs[n].buf = data;
+    n++;
+  }
+
+  rdwr.msgs = msgs;
+  rdwr.nmsgs = n;
+  syscalls++;
+  if (ioctl(_fd, I2C_RDWR, &rdwr) < 0) return (-1);
+  bytes += cmdLen + ((data) ? len : 0);
+  return ((data) ? len : 0);
+}  // transfer()
+
+
+// send one SMBus command to the device.
+int RadioLinuxBus::_smbus(uint8_t address, uint8_t readWrite, uint8_t command, int size, void *data) {
+  struct i2c_smbus_ioctl_data args;
+
+  if (address != _address) {
+    syscalls++;
+    if (ioctl(_fd, I2C_SLAVE, address) < 0) return (-1);
+    _address = address;
+  }
+
+  args.read_write = readWrite;
+  args.command = command;
+  args.size = size;
+  args.data = (union i2c_smbus_data *)data;
+  syscalls++;
+  return (ioctl(_fd, I2C_SMBUS, &args));
+}  // _smbus()
+
+
+// map a transfer to SMBus commands.
+// The first byte written is used as the command (register) for the following data.
+int RadioLinuxBus::_smbusTransfer(uint8_t address, const uint8_t *cmdData, int cmdLen, uint8_t *data, int len) {
+  union i2c_smbus_data buffer;
+
+  if ((data == nullptr) || (len == 0)) {
+    if (cmdLen == 0) {
+      // check for the device
+      return (_smbus(address, I2C_SMBUS_WRITE, 0, I2C_SMBUS_QUICK, nullptr) < 0 ? -1 : 0);
+
+    } else if (cmdLen == 1) {
+      return (_smbus(address, I2C_SMBUS_WRITE, cmdData[0], I2C_SMBUS_BYTE, nullptr) < 0 ? -1 : 0);
+
+    } else if (cmdLen - 1 <= SMBUS_BLOCKMAX) {
+      buffer.block[0] = cmdLen - 1;
+      memcpy(&buffer.block[1], cmdData + 1, cmdLen - 1);
+      return (_smbus(address, I2C_SMBUS_WRITE, cmdData[0], I2C_SMBUS_I2C_BLOCK_DATA, &buffer) < 0 ? -1 : 0);
+    }
+    return (-1);
+  }  // if
+
+  if (cmdLen == 1) {
+    // read registers starting at the register in the command.
+    for (int pos = 0; pos < len; pos += SMBUS_BLOCKMAX) {
+      int cnt = min(len - pos, SMBUS_BLOCKMAX);
+      buffer.block[0] = cnt;
+      if (_smbus(address, I2C_SMBUS_READ, cmdData[0] + pos, I2C_SMBUS_I2C_BLOCK_DATA, &buffer) < 0) return (-1);
+      memcpy(data + pos, &buffer.block[1], cnt);
+    }
+    return (len);
+  }
+
+  if ((cmdLen > 1) && (_smbusTransfer(address, cmdData, cmdLen, nullptr, 0) < 0)) return (-1);
+
+  // read bytes from the current position in the device.
+  for (int pos = 0; pos < len; pos++) {
+    if (_smbus(address, I2C_SMBUS_READ, 0, I2C_SMBUS_BYTE, &buffer) < 0) return (-1);
+    data[pos] = buffer.byte;
+  }
+  return (len);
+}  // _smbusTransfer()
@@ -0,0 +1,60 @@
+///
+/// \file RadioLinuxBus.h
+/// \brief i2c bus implementation for Linux using the i2c-dev interface.
+///
+/// \author Matthias Hertel, http://www.mathertel.de
+/// \copyright Copyright (c) by Matthias Hertel.\n
+/// This work is licensed under a BSD 3-Clause license.\n
+/// See http://www.mathertel.de/License.aspx
+///
+/// \details
+/// Every transfer is sent by a single I2C_RDWR ioctl: the write and the read message
+/// are combined with a repeated start so one register access costs one system call.
+///
+/// Adapters without plain i2c support like the i2c-stub module only offer SMBus transfers.
+/// In this case the transfers are mapped to SMBus block and byte commands,
+/// which needs more system calls but allows testing without hardware:
+///
+///     modprobe i2c-stub chip_addr=0x10,0x11
+///
+/// History:
+/// --------
+/// * 18.10.2026 created.
+
+#ifndef __RADIOLINUXBUS_H__
+#define __RADIOLINUXBUS_H__
+
+#include <radio.h>
+
+/// i2c bus on a Linux /dev/i2c-N device.
+class RadioLinuxBus : public RadioBus {
+public:
+  /// Create a bus for the given device, e.g. "/dev/i2c-1".
+  RadioLinuxBus(const char *device);
+  ~RadioLinuxBus();
+
+  /// Open the device.
+  /// \return false when the device cannot be opened.
+  bool begin() override;
+
+  /// Close the device.
+  void end();
+
+  int transfer(uint8_t address, const uint8_t *cmdData, int cmdLen, uint8_t *data, int len) override;
+
+  /// true when the adapter supports I2C_RDWR, false when only SMBus transfers are used.
+  bool isCombined() { return (_combined); };
+
+  uint32_t syscalls = 0;  ///< number of ioctl calls for the transfers.
+
+private:
+  const char *_device;
+  int _fd = -1;
+  bool _combined = true;  ///< use I2C_RDWR.
+  int _address = -1;      ///< address set by I2C_SLAVE for SMBus transfers.
+
+  int _smbus(uint8_t address, uint8_t readWrite, uint8_t command, int size, void *data);
+  int _smbusTransfer(uint8_t address, const uint8_t *cmdData, int cmdLen, uint8_t *data, int len);
+};  // RadioLinuxBus
+
+#endif  // __RADIOLINUXBUS_H__
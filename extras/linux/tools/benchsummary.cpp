@@ -0,0 +1,172 @@
+///
+/// \file benchsummary.cpp
+/// \brief Comparison table of the results of the BenchRadio example.
+///
+/// \author Matthias Hertel, http://www.mathertel.de
+/// \copyright Copyright (c) by Matthias Hertel.\n
+/// This work is licensed under a BSD 3-Clause license.\n
+/// See http://www.mathertel.de/License.aspx
+///
+/// \details
+/// Usage: benchsummary [-v value] [-m] file...
+///
+/// The files are captures of the Serial output of BenchRadio runs.
+/// Every run becomes a column named by the chip, the operations become the rows.
+/// A file starts a new run and so does every CSV header, so a capture can contain several runs.
+/// Other lines that are not results like comments are skipped.
+///
+/// The value is one of count, min, avg (default), max, transfers, bytes or timeouts.
+/// With -m the table is printed in markdown format.
+///
+/// History:
+/// --------
+/// * 18.10.2026 created.
+
+#include <unistd.h>
+
+#include <Arduino.h>
+
+#define SUMMARY_RUNS 16   ///< max. number of runs.
+#define SUMMARY_TESTS 16  ///< max. number of operations.
+#define SUMMARY_FIELDS 9  ///< fields of a result line.
+#define SUMMARY_LEN 24    ///< max. length of names and values.
+
+static const char *valueNames[] = { "count", "min", "avg", "max", "transfers", "bytes", "timeouts" };
+
+static char chips[SUMMARY_RUNS][SUMMARY_LEN];
+static char runs[SUMMARY_RUNS][SUMMARY_LEN];
+static char tests[SUMMARY_TESTS][SUMMARY_LEN];
+static char cells[SUMMARY_TESTS][SUMMARY_RUNS][SUMMARY_LEN];
+static int runCount = 0;
+static int testCount = 0;
+
+
+// split a CSV line into the fields, returns the number of fields.
+static int splitLine(char *line, char **fields, int size) {
+  int n = 0;
+
+  line[strcspn(line, "\r\n")] = '\0';
+  fields[n++] = line;
+  for (char *p = line; *p; p++) {
+    if (*p == ',') {
+      *p = '\0';
+      if (n == size) return (size + 1);
+      fields[n++] = p + 1;
+    }
+  }
+  return (n);
+}  // splitLine()
+
+
+static int findTest(const char *name) {
+  for (int n = 0; n < testCount; n++) {
+    if (strcmp(tests[n], name) == 0) return (n);
+  }
+  if (testCount == SUMMARY_TESTS) return (-1);
+  strncpy(tests[testCount], name, SUMMARY_LEN - 1);
+  return (testCount++);
+}  // findTest()
+
+
+// add the results of a file as new runs, a run starts at the file start and at every CSV header.
+static bool readRun(const char *fileName, int value) {
+  char line[256];
+  char *fields[SUMMARY_FIELDS];
+  FILE *f = fopen(fileName, "r");
+  int run = -1;
+  int first = runCount;
+
+  if (!f) {
+    perror(fileName);
+    return (false);
+  }
+
+  while (fgets(line, sizeof(line), f)) {
+    if (strncmp(line, "chip,", 5) == 0) {
+      // the next result line starts a new run.
+      run = -1;
+      continue;
+    }
+    if (line[0] == '#') continue;
+    if (splitLine(line, fields, SUMMARY_FIELDS) != SUMMARY_FIELDS) continue;
+
+    if (run < 0) {
+      if (runCount == SUMMARY_RUNS) break;
+      run = runCount++;
+
+      // the same chip in several runs gets a number.
+      snprintf(chips[run], SUMMARY_LEN, "%s", fields[0]);
+      uint8_t same = 1;  // max. SUMMARY_RUNS, the name fits in SUMMARY_LEN.
+      for (int n = 0; n < run; n++) same += (strcmp(chips[n], chips[run]) == 0);
+      if (same > 1) snprintf(runs[run], SUMMARY_LEN, "%.16s-%d", fields[0], same);
+      else snprintf(runs[run], SUMMARY_LEN, "%s", fields[0]);
+    }
+
+    int test = findTest(fields[1]);
+    if (test >= 0) snprintf(cells[test][run], SUMMARY_LEN, "%s", fields[2 + value]);
+  }
+  fclose(f);
+
+  if (first == runCount) fprintf(stderr, "%s: no results.\n", fileName);
+  return (first < runCount);
+}  // readRun()
+
+
+static void printTable(bool markdown) {
+  int width = 12;
+  for (int r = 0; r < runCount; r++) width = max(width, (int)strlen(runs[r]) + 1);
+
+  printf(markdown ? "| %-12s |" : "%-12s", "test");
+  for (int r = 0; r < runCount; r++) printf(markdown ? " %*s |" : " %*s", width, runs[r]);
+  printf("\n");
+
+  if (markdown) {
+    printf("| ------------ |");
+    for (int r = 0; r < runCount; r++) printf(" %.*s: |", width - 1, "------------------------");
+    printf("\n");
+  }
+
+  for (int t = 0; t < testCount; t++) {
+    printf(markdown ? "| %-12s |" : "%-12s", tests[t]);
+    for (int r = 0; r < runCount; r++) printf(markdown ? " %*s |" : " %*s", width, cells[t][r][0] ? cells[t][r] : "-");
+    printf("\n");
+  }
+}  // printTable()
+
+
+static void usage() {
+  fprintf(stderr, "usage: benchsummary [-v count|min|avg|max|transfers|bytes|timeouts] [-m] file...\n");
+}  // usage()
+
+
+int main(int argc, char *argv[]) {
+  int value = 2;
+  bool markdown = false;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "v:m")) != -1) {
+    if (opt == 'v') {
+      value = -1;
+      for (int n = 0; n < (int)(sizeof(valueNames) / sizeof(valueNames[0])); n++) {
+        if (strcmp(optarg, valueNames[n]) == 0) value = n;
+      }
+    } else if (opt == 'm') {
+      markdown = true;
+    }
+    if ((opt == '?') || (value < 0)) {
+      usage();
+      return (2);
+    }
+  }  // while
+
+  if (optind >= argc) {
+    usage();
+    return (2);
+  }
+
+  for (int n = optind; n < argc; n++) {
+    if (!readRun(argv[n], value)) return (1);
+  }
+  printTable(markdown);
+  return (0);
+}  // main()
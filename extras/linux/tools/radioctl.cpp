@@ -0,0 +1,191 @@
+///
+/// \file radioctl.cpp
+/// \brief Command line client for the radiod daemon.
+///
+/// \author Matthias Hertel, http://www.mathertel.de
+/// \copyright Copyright (c) by Matthias Hertel.\n
+/// This work is licensed under a BSD 3-Clause license.\n
+/// See http://www.mathertel.de/License.aspx
+///
+/// \details
+/// Usage: radioctl [-s socket] [-u tuner] command [args]
+///        radioctl [-s socket] [-u tuner] -n clients [-t seconds]
+///
+/// The first form sends a command and prints the reply.
+/// The "sub" command prints the events until the connection is closed.
+///
+/// The second form opens the given number of subscriber connections and counts the received events
+/// for the given time (default 5 seconds) to load-test the daemon.
+/// The exit code is 0 when every subscriber got at least one event.
+///
+/// History:
+/// --------
+/// * 18.10.2026 created.
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include <Arduino.h>
+
+#define RADIOCTL_LINE 256
+
+
+static int connectSocket(const char *path) {
+  struct sockaddr_un addr;
+  int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+
+  if ((fd < 0) || (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)) {
+    perror(path);
+    if (fd >= 0) close(fd);
+    return (-1);
+  }
+  return (fd);
+}  // connectSocket()
+
+
+static bool sendLine(int fd, const char *line) {
+  size_t len = strlen(line);
+  return ((write(fd, line, len) == (ssize_t)len) && (write(fd, "\n", 1) == 1));
+}  // sendLine()
+
+
+// read one line, returns false at the end of the connection.
+static bool readLine(int fd, char *line, int size) {
+  int len = 0;
+  char ch;
+
+  while (read(fd, &ch, 1) == 1) {
+    if (ch == '\n') {
+      line[len] = '\0';
+      return (true);
+    }
+    if (len < size - 1) line[len++] = ch;
+  }
+  return (false);
+}  // readLine()
+
+
+// count the events of many subscribers.
+static int loadTest(const char *path, int tuner, int count, int seconds) {
+  int epollFd = epoll_create1(EPOLL_CLOEXEC);
+  int *fds = (int *)calloc(count, sizeof(int));
+  uint32_t *lines = (uint32_t *)calloc(count, sizeof(uint32_t));
+  uint64_t bytes = 0;
+  char cmd[32];
+  char buffer[4096];
+
+  snprintf(cmd, sizeof(cmd), "tuner %d\nsub", tuner);
+  for (int n = 0; n < count; n++) {
+    fds[n] = connectSocket(path);
+    if ((fds[n] < 0) || (!sendLine(fds[n], cmd))) return (1);
+    fcntl(fds[n], F_SETFL, O_NONBLOCK);
+
+    struct epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.u32 = n;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, fds[n], &ev);
+  }
+
+  struct epoll_event events[64];
+  unsigned long start = millis();
+
+  while (millis() - start < (unsigned long)seconds * 1000) {
+    int cnt = epoll_wait(epollFd, events, 64, 100);
+    for (int i = 0; i < cnt; i++) {
+      int n = events[i].data.u32;
+      ssize_t len;
+      while ((len = read(fds[n], buffer, sizeof(buffer))) > 0) {
+        bytes += len;
+        for (ssize_t p = 0; p < len; p++) lines[n] += (buffer[p] == '\n');
+      }
+      if (len == 0) {
+        fprintf(stderr, "radioctl: connection %d closed.\n", n);
+        return (1);
+      }
+    }
+  }  // while
+
+  // the 2 replies of the commands are not counted.
+  uint32_t total = 0, low = UINT32_MAX, high = 0;
+  for (int n = 0; n < count; n++) {
+    uint32_t events = (lines[n] > 2) ? lines[n] - 2 : 0;
+    total += events;
+    low = min(low, events);
+    high = max(high, events);
+    close(fds[n]);
+  }
+
+  printf("clients:   %d\n", count);
+  printf("events:    %u (min %u, max %u per client)\n", total, low, high);
+  printf("rate:      %.1f events/sec\n", (double)total / seconds);
+  printf("bytes:     %llu\n", (unsigned long long)bytes);
+  return (low > 0 ? 0 : 1);
+}  // loadTest()
+
+
+static void usage() {
+  fprintf(stderr, "usage: radioctl [-s socket] [-u tuner] command [args]\n");
+  fprintf(stderr, "       radioctl [-s socket] [-u tuner] -n clients [-t seconds]\n");
+}  // usage()
+
+
+int main(int argc, char *argv[]) {
+  const char *path = "/tmp/radiod.sock";
+  int tuner = 0;
+  int clients = 0;
+  int seconds = 5;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "s:u:n:t:")) != -1) {
+    if (opt == 's') path = optarg;
+    else if (opt == 'u') tuner = atoi(optarg);
+    else if (opt == 'n') clients = atoi(optarg);
+    else if (opt == 't') seconds = max(1, atoi(optarg));
+    else {
+      usage();
+      return (2);
+    }
+  }  // while
+
+  if (clients > 0) return (loadTest(path, tuner, clients, seconds));
+
+  if (optind >= argc) {
+    usage();
+    return (2);
+  }
+
+  char line[RADIOCTL_LINE];
+  int len = snprintf(line, sizeof(line), "tuner %d\n", tuner);
+  for (int n = optind; n < argc; n++) {
+    len += snprintf(line + len, sizeof(line) - len, (n > optind) ? " %s" : "%s", argv[n]);
+    if (len >= (int)sizeof(line)) len = sizeof(line) - 1;  // truncated.
+  }
+
+  int fd = connectSocket(path);
+  if ((fd < 0) || (!sendLine(fd, line))) return (1);
+
+  // skip the reply of the tuner command.
+  if ((!readLine(fd, line, sizeof(line))) || (strncmp(line, "ok", 2) != 0)) {
+    fprintf(stderr, "radioctl: %s\n", line);
+    return (1);
+  }
+
+  bool stream = (strcmp(argv[optind], "sub") == 0);
+  int result = 1;
+  while (readLine(fd, line, sizeof(line))) {
+    printf("%s\n", line);
+    fflush(stdout);
+    if (result == 1) result = (strncmp(line, "ok", 2) == 0) ? 0 : 1;
+    if (!stream) break;
+  }
+  close(fd);
+  return (result);
+}  // main()
@@ -0,0 +1,825 @@
+///
+/// \file radiod.cpp
+/// \brief Daemon that owns radio tuners and offers a control API on a Unix domain socket.
+///
+/// \author Matthias Hertel, http://www.mathertel.de
+/// \copyright Copyright (c) by Matthias Hertel.\n
+/// This work is licensed under a BSD 3-Clause license.\n
+/// See http://www.mathertel.de/License.aspx
+///
+/// \details
+/// Usage: radiod [-s socket] [-c chip] [-d /dev/i2c-N | -f]... [-r groups] [-x seconds] [-v]
+///
+/// * -s is the path of the control socket, default is /tmp/radiod.sock.
+/// * -c selects the chip for the following tuners: rda5807m, si4703, si4705, si47xx or tea5767.
+/// * -d adds a tuner on the given i2c-dev device.
+/// * -f adds a tuner on a RadioFakeBus that generates RDS groups by itself.
+///   For the si4703 the bus completes tune and seek at once.
+/// * -r is the number of RDS groups per second of the fake tuners, default is 11.
+/// * -x stops the daemon after the given number of seconds.
+/// * -v prints the events and commands.
+///
+/// The clients and the RDS data are handled in a single thread by an epoll loop:
+/// The RDS data of the tuners is polled by a timerfd per tuner,
+/// commands from the clients are processed when a full line was received.
+///
+/// Tuning and seeking block for up to some seconds and are passed to a worker thread per tuner.
+/// The loop gets an eventfd signal when the job is done and sends the reply and the "freq" event.
+/// Until then the tuner is busy and all other commands for this tuner get "err busy".
+///
+/// The protocol is line based. A client sends commands that mirror the RADIO class:
+///
+///     tuner <n>             select the tuner for this connection, default is 0.
+///     freq [<freq>]         get or set the frequency, e.g. freq 8930.
+///     vol [<volume>]        get or set the volume.
+///     mute [0|1]            get or set the mute mode.
+///     mono [0|1]            get or set the mono mode.
+///     seekup, seekdown      start a seek.
+///     info                  get rssi, snr, tuned, stereo and rds.
+///     sub, unsub            start or stop receiving the events of the tuner.
+///     stats                 get the number of clients, events and dropped messages.
+///
+/// Every command gets a single reply line starting with "ok" or "err".
+/// Subscribed clients get the events "ps <tuner> <name>", "rt <tuner> <text>",
+/// "time <tuner> <hh:mm>" and "freq <tuner> <freq>".
+///
+/// An event is formatted once into a reference counted message and all subscribers queue a pointer to it.
+/// Slow subscribers lose the oldest messages when their queue is full but never block the loop.
+///
+/// History:
+/// --------
+/// * 18.10.2026 created.
+
+#include <errno.h>
+#include <stdarg.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+
+#include <radio.h>
+#include <RDA5807M.h>
+#include <SI4703.h>
+#include <SI4705.h>
+#include <SI47xx.h>
+#include <TEA5767.h>
+#include <RDSParser.h>
+
+#include "RadioLinuxBus.h"
+#include "RadioFakeBus.h"
+
+#define RADIOD_TUNERS 4     ///< max. number of tuners.
+#define RADIOD_CLIENTS 1024 ///< max. number of connected clients.
+#define RADIOD_FDS 4096     ///< max. file descriptor number of a client.
+#define RADIOD_QUEUE 64     ///< max. number of pending messages per client.
+#define RADIOD_LINE 128     ///< max. length of a command line.
+#define RADIOD_POLL 10      ///< RDS polling interval in msec.
+#define RADIOD_EVENTS 64    ///< events processed by one epoll_wait call.
+
+// tags for the epoll events that are not clients.
+#define TAG_LISTEN 0x10000
+#define TAG_SIGNAL 0x10001
+#define TAG_EXIT 0x10002
+#define TAG_TUNER 0x20000
+#define TAG_DONE 0x30000
+
+// jobs of the tuner worker threads.
+#define JOB_NONE 0
+#define JOB_FREQ 1
+#define JOB_SEEKUP 2
+#define JOB_SEEKDOWN 3
+
+
+/// A formatted event shared by all subscribers.
+struct Message {
+  uint32_t refs;
+  uint16_t len;
+  char data[RADIOD_LINE];
+};
+
+/// A connected client.
+struct Client {
+  int fd;
+  uint8_t tuner;
+  bool subscribed;
+  bool writing;  ///< EPOLLOUT is enabled.
+  char in[RADIOD_LINE];
+  uint16_t inLen;
+  Message *queue[RADIOD_QUEUE];
+  uint16_t head, count;
+  uint16_t offset;  ///< bytes of the first message already sent.
+  uint32_t dropped;
+};
+
+/// Fake bus for a SI4703 that completes tune and seek at once:
+/// STC is set while TUNE or SEEK is written and the channel is reported in READCHAN.
+/// The chip accesses the registers in a fixed order without a register address,
+/// writing starts at 02 and reading at 0A.
+class FakeSI4703Bus : public RadioFakeBus {
+public:
+  int transfer(uint8_t address, const uint8_t *cmdData, int cmdLen, uint8_t *data, int len) override {
+    int ret = RadioFakeBus::transfer(address, cmdData, cmdLen, data, len);
+
+    for (int n = 0; (n + 1 < cmdLen) && (n < 12); n += 2) {
+      _regs[0x02 + n / 2] = (cmdData[n] << 8) | cmdData[n + 1];
+    }
+
+    // STC while TUNE or SEEK is set, the channel in READCHAN.
+    _regs[0x0A] = ((_regs[0x03] & 0x8000) || (_regs[0x02] & 0x0100)) ? 0x4000 : 0;
+    _regs[0x0B] = _regs[0x03] & 0x03FF;
+
+    for (int n = 0; (data) && (n + 1 < len); n += 2) {
+      uint16_t r = _regs[(0x0A + n / 2) & 0x0F];
+      data[n] = r >> 8;
+      data[n + 1] = r & 0xFF;
+    }
+    return (ret);
+  }
+
+private:
+  uint16_t _regs[16] = {};
+};  // FakeSI4703Bus
+
+
+/// A tuner with its bus, RDS parser and worker thread.
+struct Tuner {
+  RADIO *radio;
+  RadioBus *bus;
+  RDSParser rds;
+  int timerFd;
+  bool fake;
+  uint16_t fakeGroup;  ///< position in the generated RDS groups.
+  uint32_t fakeCycle;  ///< number of generated RDS text cycles.
+
+  pthread_t thread;
+  pthread_mutex_t lock;  ///< protects job, jobArg and quit.
+  pthread_cond_t wake;
+  int doneFd;          ///< eventfd signaled by the worker when a job is done.
+  uint8_t job;         ///< the job of the worker, JOB_NONE when idle.
+  uint16_t jobArg;     ///< the frequency of JOB_FREQ.
+  bool quit;           ///< stop the worker after the current job.
+  bool busy;           ///< a job is pending, only used by the loop.
+  Client *jobClient;   ///< the client waiting for the result of the job.
+};
+
+
+static int epollFd;
+static bool verbose = false;
+
+static Tuner tuners[RADIOD_TUNERS];
+static uint8_t tunerCount = 0;
+static Tuner *activeTuner = nullptr;  ///< the tuner processing RDS data for the callbacks.
+static pthread_t loopThread;          ///< the thread running the epoll loop.
+
+static Client *clients[RADIOD_CLIENTS];
+static Client *clientOfFd[RADIOD_FDS];  ///< clients by their file descriptor.
+static int clientCount = 0;
+
+static uint32_t statEvents = 0;
+static uint32_t statDropped = 0;
+
+
+// ----- messages -----
+
+static Message *msgCreate(const char *text) {
+  Message *m = (Message *)malloc(sizeof(Message));
+  m->refs = 1;
+  // truncate long texts but keep the line end.
+  int len = snprintf(m->data, sizeof(m->data) - 1, "%s", text);
+  if (len > (int)sizeof(m->data) - 2) len = sizeof(m->data) - 2;
+  m->data[len++] = '\n';
+  m->len = len;
+  return (m);
+}  // msgCreate()
+
+
+static void msgRelease(Message *m) {
+  if (--m->refs == 0) free(m);
+}  // msgRelease()
+
+
+// ----- clients -----
+
+static void clientWatch(Client *c, bool writing) {
+  if (c->writing != writing) {
+    struct epoll_event ev;
+    ev.events = EPOLLIN;
+    if (writing) ev.events |= EPOLLOUT;
+    ev.data.u64 = c->fd;
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, c->fd, &ev);
+    c->writing = writing;
+  }
+}  // clientWatch()
+
+
+static void clientClose(Client *c) {
+  epoll_ctl(epollFd, EPOLL_CTL_DEL, c->fd, nullptr);
+  clientOfFd[c->fd] = nullptr;
+  close(c->fd);
+  for (uint8_t n = 0; n < tunerCount; n++) {
+    if (tuners[n].jobClient == c) tuners[n].jobClient = nullptr;
+  }
+  while (c->count) {
+    msgRelease(c->queue[c->head]);
+    c->head = (c->head + 1) % RADIOD_QUEUE;
+    c->count--;
+  }
+  for (int n = 0; n < clientCount; n++) {
+    if (clients[n] == c) {
+      clients[n] = clients[--clientCount];
+      break;
+    }
+  }
+  free(c);
+}  // clientClose()
+
+
+// send the queued messages with a single writev call.
+// returns false when the client is gone.
+static bool clientFlush(Client *c) {
+  struct iovec iov[RADIOD_QUEUE];
+  int cnt = 0;
+
+  while (c->count) {
+    for (cnt = 0; cnt < c->count; cnt++) {
+      Message *m = c->queue[(c->head + cnt) % RADIOD_QUEUE];
+      uint16_t skip = (cnt == 0) ? c->offset : 0;
+      iov[cnt].iov_base = m->data + skip;
+      iov[cnt].iov_len = m->len - skip;
+    }
+
+    ssize_t res = writev(c->fd, iov, cnt);
+    if (res < 0) {
+      if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) break;
+      if (errno == EINTR) continue;
+      return (false);
+    }
+
+    // release the messages that are sent completely.
+    size_t sent = res + c->offset;
+    c->offset = 0;
+    while ((c->count) && (sent >= c->queue[c->head]->len)) {
+      sent -= c->queue[c->head]->len;
+      msgRelease(c->queue[c->head]);
+      c->head = (c->head + 1) % RADIOD_QUEUE;
+      c->count--;
+    }
+    if (c->count) {
+      c->offset = sent;
+      break;
+    }
+  }  // while
+
+  clientWatch(c, c->count > 0);
+  return (true);
+}  // clientFlush()
+
+
+// add a message to the client queue, drop the oldest unsent message when full.
+static void clientQueue(Client *c, Message *m) {
+  if (c->count == RADIOD_QUEUE) {
+    // keep a partially sent message, the stream must stay line based.
+    uint16_t pos = (c->offset) ? (c->head + 1) % RADIOD_QUEUE : c->head;
+    msgRelease(c->queue[pos]);
+    if (pos != c->head) {
+      c->queue[pos] = c->queue[c->head];
+      c->queue[c->head] = nullptr;
+    } else {
+      c->offset = 0;
+    }
+    c->head = (c->head + 1) % RADIOD_QUEUE;
+    c->count--;
+    c->dropped++;
+    statDropped++;
+  }
+  m->refs++;
+  c->queue[(c->head + c->count) % RADIOD_QUEUE] = m;
+  c->count++;
+}  // clientQueue()
+
+
+// send a reply to a single client.
+static void reply(Client *c, const char *format, ...) {
+  char buffer[RADIOD_LINE];
+  va_list args;
+
+  va_start(args, format);
+  vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+
+  Message *m = msgCreate(buffer);
+  clientQueue(c, m);
+  msgRelease(m);
+}  // reply()
+
+
+// send an event of a tuner to all subscribers.
+static void publish(uint8_t tuner, const char *format, ...) {
+  char buffer[RADIOD_LINE];
+  va_list args;
+
+  va_start(args, format);
+  vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+
+  if (verbose) printf("%s\n", buffer);
+  statEvents++;
+
+  Message *m = msgCreate(buffer);
+  for (int n = 0; n < clientCount; n++) {
+    Client *c = clients[n];
+    if ((c->subscribed) && (c->tuner == tuner)) {
+      clientQueue(c, m);
+      if (!c->writing) clientFlush(c);
+    }
+  }
+  msgRelease(m);
+}  // publish()
+
+
+// ----- RDS callbacks -----
+
+static uint8_t tunerIndex(Tuner *t) {
+  return (t - tuners);
+}  // tunerIndex()
+
+
+// Some chips clear the RDS data while tuning and call this on a worker thread.
+// That is ignored as only the epoll loop may publish to the clients, tunerDone() resets the parser.
+static void receiveRDS(uint16_t block1, uint16_t block2, uint16_t block3, uint16_t block4, uint8_t errors) {
+  if (!pthread_equal(pthread_self(), loopThread)) return;
+  if (activeTuner) activeTuner->rds.processData(block1, block2, block3, block4, errors);
+}  // receiveRDS()
+
+
+static void receiveServiceName(const char *name) {
+  publish(tunerIndex(activeTuner), "ps %d %s", tunerIndex(activeTuner), name);
+}  // receiveServiceName()
+
+
+static void receiveText(const char *text) {
+  publish(tunerIndex(activeTuner), "rt %d %s", tunerIndex(activeTuner), text);
+}  // receiveText()
+
+
+static void receiveTime(uint8_t hour, uint8_t minute) {
+  publish(tunerIndex(activeTuner), "time %d %02d:%02d", tunerIndex(activeTuner), hour, minute);
+}  // receiveTime()
+
+
+// ----- tuners -----
+
+// generate the next RDS group of a fake tuner: 4 PS groups and 8 RT groups per cycle.
+static void fakeRDS(Tuner *t) {
+  char ps[12];  // only 8 chars are sent.
+  char rt[33];
+  uint16_t pi = 0xD000 + tunerIndex(t);
+  uint8_t seg;
+
+  snprintf(ps, sizeof(ps), "RADIOD %d", tunerIndex(t));
+  snprintf(rt, sizeof(rt), "Fake radio text %-16u", t->fakeCycle);
+
+  if (t->fakeGroup < 4) {
+    seg = t->fakeGroup;
+    t->rds.processData(pi, (0x0 << 12) | seg, 0xE0CD, (ps[2 * seg] << 8) | ps[2 * seg + 1], 0);
+  } else {
+    seg = t->fakeGroup - 4;
+    t->rds.processData(pi, (0x2 << 12) | seg, (rt[4 * seg] << 8) | rt[4 * seg + 1], (rt[4 * seg + 2] << 8) | rt[4 * seg + 3], 0);
+  }
+
+  if (++t->fakeGroup == 12) {
+    t->fakeGroup = 0;
+    t->fakeCycle++;
+  }
+}  // fakeRDS()
+
+
+static void tunerTimer(Tuner *t) {
+  uint64_t expirations;
+
+  if (read(t->timerFd, &expirations, sizeof(expirations)) != sizeof(expirations)) return;
+
+  activeTuner = t;
+  if (t->fake) {
+    while (expirations--) fakeRDS(t);
+  } else if (!t->busy) {
+    // the radio belongs to the worker while a job is pending.
+    t->radio->checkRDS();
+  }
+  activeTuner = nullptr;
+}  // tunerTimer()
+
+
+// execute the blocking jobs of a tuner.
+static void *tunerWorker(void *arg) {
+  Tuner *t = (Tuner *)arg;
+
+  pthread_mutex_lock(&t->lock);
+  while (true) {
+    while ((t->job == JOB_NONE) && (!t->quit)) pthread_cond_wait(&t->wake, &t->lock);
+    if (t->job == JOB_NONE) break;
+    uint8_t job = t->job;
+    pthread_mutex_unlock(&t->lock);
+
+    if (job == JOB_FREQ) t->radio->setFrequency(t->jobArg);
+    else if (job == JOB_SEEKUP) t->radio->seekUp(true);
+    else t->radio->seekDown(true);
+
+    pthread_mutex_lock(&t->lock);
+    t->job = JOB_NONE;
+    eventfd_write(t->doneFd, 1);
+  }  // while
+  pthread_mutex_unlock(&t->lock);
+  return (nullptr);
+}  // tunerWorker()
+
+
+// pass a job to the worker of the tuner, the client gets the reply when it is done.
+static void tunerStart(Tuner *t, Client *c, uint8_t job, uint16_t arg) {
+  t->busy = true;
+  t->jobClient = c;
+  pthread_mutex_lock(&t->lock);
+  t->job = job;
+  t->jobArg = arg;
+  pthread_cond_signal(&t->wake);
+  pthread_mutex_unlock(&t->lock);
+}  // tunerStart()
+
+
+// the worker has finished a job: restart RDS and send the new frequency.
+static void tunerDone(Tuner *t) {
+  eventfd_t value;
+
+  if (eventfd_read(t->doneFd, &value) < 0) return;
+
+  // the lock makes the changes of the worker visible.
+  pthread_mutex_lock(&t->lock);
+  pthread_mutex_unlock(&t->lock);
+  t->busy = false;
+
+  uint8_t n = tunerIndex(t);
+  int freq = t->radio->getFrequency();
+  t->rds.init();
+  publish(n, "freq %d %d", n, freq);
+
+  Client *c = t->jobClient;
+  t->jobClient = nullptr;
+  if (c) {
+    reply(c, "ok freq %d", freq);
+    if (!c->writing) clientFlush(c);
+  }
+}  // tunerDone()
+
+
+static RADIO *createRadio(const char *chip, uint8_t *adr) {
+  adr[0] = adr[1] = 0;
+  if (strcmp(chip, "rda5807m") == 0) {
+    adr[0] = 0x10;
+    adr[1] = 0x11;
+    return (new RDA5807M());
+  } else if (strcmp(chip, "si4703") == 0) {
+    adr[0] = 0x10;
+    return (new SI4703());
+  } else if (strcmp(chip, "si4705") == 0) {
+    adr[0] = 0x63;
+    return (new SI4705());
+  } else if (strcmp(chip, "si47xx") == 0) {
+    adr[0] = 0x11;
+    return (new SI47xx());
+  } else if (strcmp(chip, "tea5767") == 0) {
+    adr[0] = 0x60;
+    return (new TEA5767());
+  }
+  return (nullptr);
+}  // createRadio()
+
+
+static bool addTuner(const char *chip, const char *device, int groupRate) {
+  uint8_t adr[2];
+  struct itimerspec its;
+
+  if (tunerCount == RADIOD_TUNERS) return (false);
+  Tuner *t = &tuners[tunerCount];
+
+  t->radio = createRadio(chip, adr);
+  if (!t->radio) return (false);
+
+  if (device) {
+    t->bus = new RadioLinuxBus(device);
+    t->fake = false;
+  } else {
+    RadioFakeBus *fakeBus = (strcmp(chip, "si4703") == 0) ? new FakeSI4703Bus() : new RadioFakeBus();
+    for (uint8_t n = 0; n < 2; n++) {
+      if (adr[n]) {
+        fakeBus->addDevice(adr[n]);
+        // the SI47xx chips report "clear to send" in the status byte.
+        if (adr[n] != 0x10) memset(fakeBus->getMemory(adr[n]), 0x80, 256);
+      }
+    }
+    t->bus = fakeBus;
+    t->fake = true;
+  }
+
+  if (!t->radio->initBus(*t->bus)) return (false);
+  // the chips need a band before the first frequency.
+  t->radio->setBand(RADIO_BAND_FM);
+  t->radio->attachReceiveRDSExt(receiveRDS);
+  t->rds.init();
+  t->rds.attachServiceNameCallback(receiveServiceName);
+  t->rds.attachTextCallback(receiveText);
+  t->rds.attachTimeCallback(receiveTime);
+
+  long interval = t->fake ? (1000000000L / groupRate) : (RADIOD_POLL * 1000000L);
+  its.it_interval.tv_sec = interval / 1000000000L;
+  its.it_interval.tv_nsec = interval % 1000000000L;
+  its.it_value = its.it_interval;
+  t->timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  timerfd_settime(t->timerFd, 0, &its, nullptr);
+
+  struct epoll_event ev;
+  ev.events = EPOLLIN;
+  ev.data.u64 = TAG_TUNER + tunerCount;
+  epoll_ctl(epollFd, EPOLL_CTL_ADD, t->timerFd, &ev);
+
+  t->doneFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  ev.data.u64 = TAG_DONE + tunerCount;
+  epoll_ctl(epollFd, EPOLL_CTL_ADD, t->doneFd, &ev);
+
+  pthread_mutex_init(&t->lock, nullptr);
+  pthread_cond_init(&t->wake, nullptr);
+  pthread_create(&t->thread, nullptr, tunerWorker, t);
+
+  tunerCount++;
+  return (true);
+}  // addTuner()
+
+
+// ----- commands -----
+
+static void command(Client *c, char *line) {
+  char *cmd = strtok(line, " \t");
+  char *arg = strtok(nullptr, " \t");
+
+  if (!cmd) return;
+  if (verbose) printf("> %s %s\n", cmd, arg ? arg : "");
+
+  Tuner *t = &tuners[c->tuner];
+  RADIO *radio = t->radio;
+
+  if (strcmp(cmd, "tuner") == 0) {
+    if (arg) {
+      int n = atoi(arg);
+      if ((n < 0) || (n >= tunerCount)) {
+        reply(c, "err no tuner %d", n);
+        return;
+      }
+      c->tuner = n;
+    }
+    reply(c, "ok tuner %d", c->tuner);
+
+  } else if (strcmp(cmd, "sub") == 0) {
+    c->subscribed = true;
+    reply(c, "ok sub %d", c->tuner);
+
+  } else if (strcmp(cmd, "unsub") == 0) {
+    c->subscribed = false;
+    reply(c, "ok unsub");
+
+  } else if (strcmp(cmd, "stats") == 0) {
+    int subs = 0;
+    for (int n = 0; n < clientCount; n++) subs += clients[n]->subscribed;
+    reply(c, "ok stats clients=%d subscribers=%d events=%u dropped=%u", clientCount, subs, statEvents, statDropped);
+
+  } else if (t->busy) {
+    // the other commands use the radio that is owned by the worker now.
+    reply(c, "err busy");
+
+  } else if (strcmp(cmd, "freq") == 0) {
+    if (arg) tunerStart(t, c, JOB_FREQ, atoi(arg));
+    else reply(c, "ok freq %d", radio->getFrequency());
+
+  } else if (strcmp(cmd, "vol") == 0) {
+    if (arg) radio->setVolume(atoi(arg));
+    reply(c, "ok vol %d", radio->getVolume());
+
+  } else if (strcmp(cmd, "mute") == 0) {
+    if (arg) radio->setMute(atoi(arg));
+    reply(c, "ok mute %d", radio->getMute());
+
+  } else if (strcmp(cmd, "mono") == 0) {
+    if (arg) radio->setMono(atoi(arg));
+    reply(c, "ok mono %d", radio->getMono());
+
+  } else if ((strcmp(cmd, "seekup") == 0) || (strcmp(cmd, "seekdown") == 0)) {
+    tunerStart(t, c, (cmd[4] == 'u') ? JOB_SEEKUP : JOB_SEEKDOWN, 0);
+
+  } else if (strcmp(cmd, "info") == 0) {
+    RADIO_INFO info;
+    radio->getRadioInfo(&info);
+    reply(c, "ok info rssi=%d snr=%d tuned=%d stereo=%d rds=%d", info.rssi, info.snr, info.tuned, info.stereo, info.rds);
+
+  } else {
+    reply(c, "err unknown command %s", cmd);
+  }
+}  // command()
+
+
+// ----- socket -----
+
+static void clientAccept(int listenFd) {
+  int fd;
+
+  while ((fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+    if ((clientCount == RADIOD_CLIENTS) || (fd >= RADIOD_FDS)) {
+      close(fd);
+      continue;
+    }
+    Client *c = (Client *)calloc(1, sizeof(Client));
+    c->fd = fd;
+    clients[clientCount++] = c;
+    clientOfFd[fd] = c;
+
+    struct epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.u64 = fd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev);
+  }  // while
+}  // clientAccept()
+
+
+// read the available data and process all complete lines.
+// returns false when the client is gone.
+static bool clientRead(Client *c) {
+  char buffer[512];
+  ssize_t len;
+
+  while ((len = read(c->fd, buffer, sizeof(buffer))) > 0) {
+    for (ssize_t n = 0; n < len; n++) {
+      char ch = buffer[n];
+      if (ch == '\n') {
+        c->in[c->inLen] = '\0';
+        if ((c->inLen) && (c->in[c->inLen - 1] == '\r')) c->in[c->inLen - 1] = '\0';
+        command(c, c->in);
+        c->inLen = 0;
+      } else if (c->inLen < RADIOD_LINE - 1) {
+        c->in[c->inLen++] = ch;
+      }
+    }
+  }  // while
+
+  if ((len == 0) || ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR))) return (false);
+  return (clientFlush(c));
+}  // clientRead()
+
+
+static int listenSocket(const char *path) {
+  struct sockaddr_un addr;
+  int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+  unlink(path);
+
+  if ((fd < 0) || (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) || (listen(fd, 128) < 0)) {
+    perror(path);
+    return (-1);
+  }
+  return (fd);
+}  // listenSocket()
+
+
+static void addWatch(int fd, uint64_t tag) {
+  struct epoll_event ev;
+  ev.events = EPOLLIN;
+  ev.data.u64 = tag;
+  epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev);
+}  // addWatch()
+
+
+static void usage() {
+  fprintf(stderr, "usage: radiod [-s socket] [-c chip] [-d /dev/i2c-N | -f]... [-r groups] [-x seconds] [-v]\n");
+}  // usage()
+
+
+int main(int argc, char *argv[]) {
+  const char *path = "/tmp/radiod.sock";
+  const char *chip = "rda5807m";
+  int groupRate = 11;
+  int exitTime = 0;
+  int opt;
+
+  epollFd = epoll_create1(EPOLL_CLOEXEC);
+  loopThread = pthread_self();
+
+  // the -r option must be known before the tuners are added.
+  while ((opt = getopt(argc, argv, "s:c:d:fr:x:v")) != -1) {
+    if (opt == 'r') groupRate = max(1, atoi(optarg));
+    else if (opt == '?') {
+      usage();
+      return (2);
+    }
+  }
+
+  optind = 1;
+  while ((opt = getopt(argc, argv, "s:c:d:fr:x:v")) != -1) {
+    if (opt == 's') path = optarg;
+    else if (opt == 'c') chip = optarg;
+    else if (opt == 'x') exitTime = atoi(optarg);
+    else if (opt == 'v') verbose = true;
+    else if ((opt == 'd') || (opt == 'f')) {
+      const char *device = (opt == 'd') ? optarg : nullptr;
+      if (!addTuner(chip, device, groupRate)) {
+        fprintf(stderr, "radiod: no %s found on %s.\n", chip, device ? device : "fake bus");
+        return (1);
+      }
+    }
+  }  // while
+
+  if ((tunerCount == 0) && (!addTuner(chip, "/dev/i2c-1", groupRate))) {
+    fprintf(stderr, "radiod: no %s found on /dev/i2c-1.\n", chip);
+    return (1);
+  }
+
+  int listenFd = listenSocket(path);
+  if (listenFd < 0) return (1);
+  addWatch(listenFd, TAG_LISTEN);
+
+  // stop by signals, broken connections are detected by writev.
+  sigset_t mask;
+  sigemptyset(&mask);
+  sigaddset(&mask, SIGINT);
+  sigaddset(&mask, SIGTERM);
+  sigprocmask(SIG_BLOCK, &mask, nullptr);
+  signal(SIGPIPE, SIG_IGN);
+  addWatch(signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC), TAG_SIGNAL);
+
+  if (exitTime > 0) {
+    struct itimerspec its;
+    memset(&its, 0, sizeof(its));
+    its.it_value.tv_sec = exitTime;
+    int fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    timerfd_settime(fd, 0, &its, nullptr);
+    addWatch(fd, TAG_EXIT);
+  }
+
+  printf("radiod: %d tuner(s) on %s\n", tunerCount, path);
+  fflush(stdout);
+
+  struct epoll_event events[RADIOD_EVENTS];
+  bool running = true;
+
+  while (running) {
+    int cnt = epoll_wait(epollFd, events, RADIOD_EVENTS, -1);
+    if ((cnt < 0) && (errno != EINTR)) break;
+
+    for (int n = 0; n < cnt; n++) {
+      uint64_t tag = events[n].data.u64;
+
+      if (tag == TAG_LISTEN) {
+        clientAccept(listenFd);
+
+      } else if ((tag == TAG_SIGNAL) || (tag == TAG_EXIT)) {
+        running = false;
+
+      } else if (tag >= TAG_DONE) {
+        tunerDone(&tuners[tag - TAG_DONE]);
+
+      } else if (tag >= TAG_TUNER) {
+        tunerTimer(&tuners[tag - TAG_TUNER]);
+
+      } else {
+        Client *c = clientOfFd[tag];
+        if (!c) continue;
+        bool ok = true;
+        if (events[n].events & (EPOLLERR | EPOLLHUP)) ok = false;
+        if ((ok) && (events[n].events & EPOLLIN)) ok = clientRead(c);
+        if ((ok) && (events[n].events & EPOLLOUT)) ok = clientFlush(c);
+        if (!ok) clientClose(c);
+      }
+    }  // for
+  }  // while
+
+  // let the workers finish their current job.
+  for (uint8_t n = 0; n < tunerCount; n++) {
+    Tuner *t = &tuners[n];
+    pthread_mutex_lock(&t->lock);
+    t->quit = true;
+    pthread_cond_signal(&t->wake);
+    pthread_mutex_unlock(&t->lock);
+    pthread_join(t->thread, nullptr);
+  }
+
+  while (clientCount) clientClose(clients[0]);
+  close(listenFd);
+  unlink(path);
+  printf("radiod: %u events, %u dropped\n", statEvents, statDropped);
+  return (0);
+}  // main()
@@ -0,0 +1,128 @@
+///
+/// \file radioinfo.cpp
+/// \brief Command line tool to initialize a radio chip on Linux and print its status.
+///
+/// \author Matthias Hertel, http://www.mathertel.de
+/// \copyright Copyright (c) by Matthias Hertel.\n
+/// This work is licensed under a BSD 3-Clause license.\n
+/// See http://www.mathertel.de/License.aspx
+///
+/// \details
+/// Usage: radioinfo [-d /dev/i2c-N | -f] [-c chip] [-v] [frequency]
+///
+/// * -d uses the given i2c-dev device, default is /dev/i2c-1.
+/// * -f uses the in-process RadioFakeBus with the addresses of the chip.
+/// * -c selects the chip: rda5807m, si4703, si4705, si47xx or tea5767.
+/// * -v enables the i2c debug output of the library.
+/// * The frequency is given in the units of the library, e.g. 8930 for 89.30 MHz.
+///
+/// At the end the number of i2c transfers and system calls are printed.
+///
+/// History:
+/// --------
+/// * 18.10.2026 created.
+
+#include <unistd.h>
+
+#include <radio.h>
+#include <RDA5807M.h>
+#include <SI4703.h>
+#include <SI4705.h>
+#include <SI47xx.h>
+#include <TEA5767.h>
+
+#include "RadioLinuxBus.h"
+#include "RadioFakeBus.h"
+
+
+static void usage() {
+  fprintf(stderr, "usage: radioinfo [-d /dev/i2c-N | -f] [-c rda5807m|si4703|si4705|si47xx|tea5767] [-v] [frequency]\n");
+}  // usage()
+
+
+int main(int argc, char *argv[]) {
+  const char *device = "/dev/i2c-1";
+  const char *chip = "rda5807m";
+  bool fake = false;
+  bool verbose = false;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "d:fc:v")) != -1) {
+    if (opt == 'd') device = optarg;
+    else if (opt == 'f') fake = true;
+    else if (opt == 'c') chip = optarg;
+    else if (opt == 'v') verbose = true;
+    else {
+      usage();
+      return (2);
+    }
+  }  // while
+
+  RADIO *radio;
+  uint8_t adr[2] = { 0, 0 };
+
+  if (strcmp(chip, "rda5807m") == 0) {
+    radio = new RDA5807M();
+    adr[0] = 0x10;
+    adr[1] = 0x11;
+  } else if (strcmp(chip, "si4703") == 0) {
+    radio = new SI4703();
+    adr[0] = 0x10;
+  } else if (strcmp(chip, "si4705") == 0) {
+    radio = new SI4705();
+    adr[0] = 0x63;
+  } else if (strcmp(chip, "si47xx") == 0) {
+    radio = new SI47xx();
+    adr[0] = 0x11;
+  } else if (strcmp(chip, "tea5767") == 0) {
+    radio = new TEA5767();
+    adr[0] = 0x60;
+  } else {
+    usage();
+    return (2);
+  }
+
+  RadioLinuxBus linuxBus(device);
+  RadioFakeBus fakeBus;
+  RadioBus *bus = &linuxBus;
+
+  if (fake) {
+    for (uint8_t n = 0; n < 2; n++) {
+      if (adr[n]) {
+        fakeBus.addDevice(adr[n]);
+        // the SI47xx chips report "clear to send" in the status byte.
+        if (adr[n] != 0x10) memset(fakeBus.getMemory(adr[n]), 0x80, 256);
+      }
+    }
+    bus = &fakeBus;
+  }
+
+  radio->debugEnable(verbose);
+  radio->_wireDebug(verbose);
+
+  if (!radio->initBus(*bus)) {
+    fprintf(stderr, "radioinfo: no %s found on %s.\n", chip, fake ? "fake bus" : device);
+    return (1);
+  }
+
+  if (optind < argc) {
+    radio->setBandFrequency(RADIO_BAND_FM, atoi(argv[optind]));
+  }
+
+  RADIO_INFO info;
+  char s[12];
+
+  radio->getRadioInfo(&info);
+  radio->formatFrequency(s, sizeof(s));
+  printf("chip:      %s\n", chip);
+  printf("frequency: %s\n", s);
+  printf("rssi:      %d\n", info.rssi);
+  printf("snr:       %d\n", info.snr);
+  printf("tuned:     %d stereo: %d rds: %d\n", info.tuned, info.stereo, info.rds);
+
+  printf("transfers: %u (%u bytes)\n", bus->transfers, bus->bytes);
+  if (!fake) {
+    printf("syscalls:  %u (%s)\n", linuxBus.syscalls, linuxBus.isCombined() ? "I2C_RDWR" : "SMBus");
+  }
+  return (0);
+}  // main()
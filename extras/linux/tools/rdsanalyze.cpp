@@ -0,0 +1,638 @@
+///
+/// \file rdsanalyze.cpp
+/// \brief Analyze captured RDS groups and print a summary per station.
+///
+/// \author Matthias Hertel, http://www.mathertel.de
+/// \copyright Copyright (c) by Matthias Hertel.\n
+/// This work is licensed under a BSD 3-Clause license.\n
+/// See http://www.mathertel.de/License.aspx
+///
+/// \details
+/// Usage: rdsanalyze [-j threads] [-q] file...
+///        rdsanalyze -w file [-n groups] [-l]
+///
+/// The files are logs in the RDSLog format, e.g. recorded by the WebRadio example,
+/// or captured RadioFrames streams from the SerialRadio or ScanRadio examples
+/// in binary mode with the RDS stream enabled, e.g. by `cat /dev/ttyUSB0 > site.bin`.
+/// The RDS frames carry the groups and the status frames the frequency and the time of the device.
+///
+/// The files are memory mapped and shared across the threads, one file per thread at a time.
+/// Every thread collects the frames into batches of groups as arrays per block.
+/// The group types of a batch are classified by a simple loop the compiler can vectorize
+/// and only the groups that are used by the RDSParser (0A, 0B, 2A, 4A) are passed to a parser per station.
+///
+/// Groups with an uncorrectable block A belong to the station of the last clean PI code.
+/// RadioFrames captures without the error levels in the RDS frame only contain correct groups.
+///
+/// The summary contains for every station (PI code) the frequency, the number of groups,
+/// the histogram of the group types, the history of the service names and RDS texts
+/// and the drift of the RDS clock time against the time of the device.
+/// The drift is measured only at the minute changes that are seen in consecutive clock time groups,
+/// e.g. not at the first clock time after a retune.
+///
+/// The -w option writes a generated capture with 3 stations for testing and benchmarks,
+/// as a RadioFrames stream or with -l in the RDSLog format.
+/// Both formats get some groups with a broken PI code that is marked as uncorrectable.
+///
+/// History:
+/// --------
+/// * 18.10.2026 created.
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <atomic>
+#include <thread>
+
+#include <radio.h>
+#include <RDSParser.h>
+#include <RadioFrames.h>
+#include <RDSLog.h>
+
+#define ANALYZE_BATCH 4096     ///< number of groups in a batch.
+#define ANALYZE_STATIONS 256   ///< max. number of stations per thread.
+#define ANALYZE_HISTORY 8      ///< number of entries in the PS and RT history.
+#define ANALYZE_TYPES 32       ///< group types 0A...15B
+#define ANALYZE_CTGAP 10000    ///< max. msec. between 2 clock time groups to see the minute change.
+
+// bits of the group types that are processed by the RDSParser: 0A, 0B, 2A, 4A.
+#define ANALYZE_PARSED ((1UL << 0) | (1UL << 1) | (1UL << 4) | (1UL << 8))
+
+
+/// A text with the number of occurrences.
+struct History {
+  char text[65];
+  uint32_t count;
+};
+
+/// Collected data of a station.
+struct Station {
+  uint16_t pi;
+  RADIO_FREQ freq;
+  uint64_t groups;
+  uint64_t types[ANALYZE_TYPES];
+  History ps[ANALYZE_HISTORY];
+  uint8_t psCount;
+  History rt[ANALYZE_HISTORY];
+  uint8_t rtCount;
+  uint32_t ctCount;
+  uint32_t ctTime;  ///< device time of the last clock time group, 0 for none.
+  long ctFirst;  ///< first offset of the RDS clock time to the device time in seconds.
+  long ctLast;   ///< last offset.
+  RDSParser *rds;
+};
+
+/// Groups of a batch as arrays per block.
+struct Batch {
+  uint16_t block1[ANALYZE_BATCH];
+  uint16_t block2[ANALYZE_BATCH];
+  uint16_t block3[ANALYZE_BATCH];
+  uint16_t block4[ANALYZE_BATCH];
+  RADIO_FREQ freq[ANALYZE_BATCH];
+  uint32_t time[ANALYZE_BATCH];  ///< device time in msec.
+  uint8_t errors[ANALYZE_BATCH];
+  uint8_t type[ANALYZE_BATCH];
+  int count;
+};
+
+/// The data of a thread.
+struct Shard {
+  Station stations[ANALYZE_STATIONS];
+  int count;
+  uint64_t groups;
+  uint64_t frames;
+  uint64_t crcErrors;
+  uint64_t lostSectors;
+  uint64_t noPI;      ///< groups with an uncorrectable block A before the first clean one.
+  uint64_t bytes;
+  Station *current;   ///< the station of the last group with a clean PI code.
+  Batch batch;
+};
+
+
+static thread_local Station *activeStation;  ///< the station of the group in the RDSParser callbacks.
+static thread_local uint32_t activeTime;     ///< the device time of the group in the RDSParser callbacks.
+
+
+// ----- RDSParser callbacks -----
+
+static void addHistory(History *list, uint8_t &count, const char *text) {
+  if (!text[0]) return;
+  for (uint8_t n = 0; n < count; n++) {
+    if (strcmp(list[n].text, text) == 0) {
+      list[n].count++;
+      return;
+    }
+  }
+  if (count < ANALYZE_HISTORY) {
+    strncpy(list[count].text, text, sizeof(list[count].text) - 1);
+    list[count].count = 1;
+    count++;
+  }
+}  // addHistory()
+
+
+static void receiveServiceName(const char *name) {
+  addHistory(activeStation->ps, activeStation->psCount, name);
+}  // receiveServiceName()
+
+
+static void receiveText(const char *text) {
+  addHistory(activeStation->rt, activeStation->rtCount, text);
+}  // receiveText()
+
+
+static void receiveTime(uint8_t hour, uint8_t minute) {
+  Station *s = activeStation;
+
+  // the minute just started only when the previous clock time group was a short time ago.
+  if ((!s->ctTime) || (activeTime - s->ctTime > ANALYZE_CTGAP)) return;
+
+  // offset of the clock time to the device time in seconds in the range of a day.
+  long offset = (long)(hour * 60 + minute) * 60 - (long)(activeTime / 1000);
+  offset = ((offset % 86400) + 86400) % 86400;
+
+  if (s->ctCount == 0) {
+    s->ctFirst = offset;
+  } else if (offset - s->ctFirst > 43200) {
+    offset -= 86400;
+  } else if (s->ctFirst - offset > 43200) {
+    offset += 86400;
+  }
+  s->ctLast = offset;
+  s->ctCount++;
+}  // receiveTime()
+
+
+// ----- analyzing -----
+
+// find a station of a shard, create can add a new station.
+// Only the stations of the threads need a RDSParser, the merged total has none.
+static Station *findStation(Shard *shard, uint16_t pi, bool create, bool parser) {
+  for (int n = 0; n < shard->count; n++) {
+    if (shard->stations[n].pi == pi) return (&shard->stations[n]);
+  }
+  if ((!create) || (shard->count == ANALYZE_STATIONS)) return (nullptr);
+
+  Station *s = &shard->stations[shard->count++];
+  memset(s, 0, sizeof(Station));
+  s->pi = pi;
+  if (!parser) return (s);
+
+  s->rds = new RDSParser();
+  s->rds->init();
+  s->rds->attachServiceNameCallback(receiveServiceName);
+  s->rds->attachTextCallback(receiveText);
+  s->rds->attachTimeCallback(receiveTime);
+  return (s);
+}  // findStation()
+
+
+/// Classify the group types of a batch: 0A = 0, 0B = 1, 2A = 4 ... 15B = 31.
+/// This loop has no dependencies between the groups and is vectorized by the compiler.
+static void classifyGroups(const uint16_t *__restrict block2, uint8_t *__restrict type, int count) {
+  for (int n = 0; n < count; n++) {
+    type[n] = (uint8_t)(block2[n] >> 11);
+  }
+}  // classifyGroups()
+
+
+static void processBatch(Shard *shard) {
+  Batch *b = &shard->batch;
+  Station *s = shard->current;
+
+  classifyGroups(b->block2, b->type, b->count);
+
+  for (int n = 0; n < b->count; n++) {
+    if (RDS_BLOCKERR(b->errors[n], 0) == RDS_ERRLEVEL_UNCORRECT) {
+      // the PI code is broken, the group belongs to the last station.
+      if (!s) {
+        shard->noPI++;
+        continue;
+      }
+    } else if ((!s) || (s->pi != b->block1[n])) {
+      s = findStation(shard, b->block1[n], true, true);
+      if (!s) continue;
+    }
+    s->freq = b->freq[n];
+    s->groups++;
+    s->types[b->type[n]]++;
+
+    if (ANALYZE_PARSED & (1UL << b->type[n])) {
+      activeStation = s;
+      activeTime = b->time[n];
+      s->rds->processData(b->block1[n], b->block2[n], b->block3[n], b->block4[n], b->errors[n]);
+      if (b->type[n] == 0x08) s->ctTime = b->time[n];
+    }
+  }  // for
+
+  shard->current = s;
+  shard->groups += b->count;
+  b->count = 0;
+}  // processBatch()
+
+
+// scan the RadioFrames in a memory mapped file.
+static void processFile(Shard *shard, const uint8_t *data, size_t size) {
+  Batch *b = &shard->batch;
+  RADIO_FREQ freq = 0;
+  uint32_t time = 0;
+  size_t pos = 0;
+
+  while (pos + 5 <= size) {
+    uint8_t len = data[pos + 1];
+
+    if ((data[pos] != RADIOFRAME_SYNC) || (len > RADIOFRAME_MAXDATA) || (pos + 5 + len > size)) {
+      pos++;
+      continue;
+    }
+
+    const uint8_t *frame = data + pos;
+    uint16_t crc = 0xFFFF;
+    for (uint8_t n = 1; n < 3 + len; n++) {
+      crc = RadioFrames::crc16(crc, frame[n]);
+    }
+    if (crc != ((frame[3 + len] << 8) | frame[4 + len])) {
+      // not a frame, search the next sync byte.
+      shard->crcErrors++;
+      pos++;
+      continue;
+    }
+
+    const uint8_t *p = frame + 3;
+    if ((frame[2] == RADIOFRAME_STATUS) && (len >= 11)) {
+      freq = (p[0] << 8) | p[1];
+      time = ((uint32_t)p[7] << 24) | ((uint32_t)p[8] << 16) | ((uint32_t)p[9] << 8) | p[10];
+
+    } else if ((frame[2] == RADIOFRAME_RDS) && (len >= 8)) {
+      // captures without the error levels only contain correct groups.
+      int n = b->count++;
+      b->block1[n] = (p[0] << 8) | p[1];
+      b->block2[n] = (p[2] << 8) | p[3];
+      b->block3[n] = (p[4] << 8) | p[5];
+      b->block4[n] = (p[6] << 8) | p[7];
+      b->freq[n] = freq;
+      b->time[n] = time;
+      b->errors[n] = (len >= 9) ? p[8] : 0;
+      if (b->count == ANALYZE_BATCH) processBatch(shard);
+    }
+    shard->frames++;
+    pos += 5 + len;
+  }  // while
+
+  if (b->count) processBatch(shard);
+}  // processFile()
+
+
+static uint16_t get16(const uint8_t *p) {
+  return (p[0] | (p[1] << 8));
+}  // get16()
+
+
+// read the sectors of a file in the RDSLog format, several logs can be appended in one file.
+static void processLog(Shard *shard, const uint8_t *data, size_t size) {
+  Batch *b = &shard->batch;
+  RADIO_FREQ freq = 0;
+  uint16_t sequence = 0;
+
+  for (size_t pos = 0; pos + RDSLOG_SECTORSIZE <= size; pos += RDSLOG_SECTORSIZE) {
+    const uint8_t *s = data + pos;
+
+    if (memcmp(s, "RDSLOG\0\0", 8) == 0) {
+      // a new log starts.
+      freq = 0;
+      sequence = 0;
+      continue;
+    }
+    if (get16(s) != RDSLOG_SECTORMAGIC) {
+      // counted once here, the next sector is expected with the following sequence number.
+      shard->lostSectors++;
+      sequence++;
+      continue;
+    }
+    shard->lostSectors += (uint16_t)(get16(s + 2) - sequence);
+    sequence = get16(s + 2) + 1;
+    shard->frames++;
+
+    uint32_t time = get16(s + 4) | ((uint32_t)get16(s + 6) << 16);
+    for (int r = 0; r < RDSLOG_RECORDS; r++) {
+      const uint8_t *p = s + RDSLOG_SECTORHEADER + RDSLOG_RECORDSIZE * r;
+      uint8_t tag = p[2];
+      time += get16(p);
+
+      if (tag == RDSLOG_TAG_NONE) continue;
+      if (tag == RDSLOG_TAG_FREQ) {
+        freq = get16(p + 4);
+        continue;
+      }
+
+      int n = b->count++;
+      b->block1[n] = get16(p + 4);
+      b->block2[n] = get16(p + 6);
+      b->block3[n] = get16(p + 8);
+      b->block4[n] = get16(p + 10);
+      b->freq[n] = (tag <= RDSLOG_TAG_MAX) ? 8750 + 10 * tag : freq;
+      b->time[n] = time;
+      b->errors[n] = p[3];
+      if (b->count == ANALYZE_BATCH) processBatch(shard);
+    }  // for
+  }  // for
+
+  if (b->count) processBatch(shard);
+}  // processLog()
+
+
+static bool mapFile(Shard *shard, const char *name) {
+  struct stat st;
+  int fd = open(name, O_RDONLY);
+
+  if ((fd < 0) || (fstat(fd, &st) < 0)) {
+    perror(name);
+    if (fd >= 0) close(fd);
+    return (false);
+  }
+
+  shard->current = nullptr;
+  if (st.st_size > 0) {
+    void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      perror(name);
+      close(fd);
+      return (false);
+    }
+    madvise(data, st.st_size, MADV_SEQUENTIAL);
+    if ((st.st_size >= RDSLOG_SECTORSIZE) && (memcmp(data, "RDSLOG", 6) == 0)) {
+      processLog(shard, (const uint8_t *)data, st.st_size);
+    } else {
+      processFile(shard, (const uint8_t *)data, st.st_size);
+    }
+    munmap(data, st.st_size);
+    shard->bytes += st.st_size;
+  }
+  close(fd);
+  return (true);
+}  // mapFile()
+
+
+// ----- summary -----
+
+static void mergeHistory(History *list, uint8_t &count, const History *add, uint8_t addCount) {
+  for (uint8_t n = 0; n < addCount; n++) {
+    uint8_t i = 0;
+    while ((i < count) && (strcmp(list[i].text, add[n].text) != 0)) i++;
+    if (i < count) {
+      list[i].count += add[n].count;
+    } else if (count < ANALYZE_HISTORY) {
+      list[count++] = add[n];
+    }
+  }
+}  // mergeHistory()
+
+
+static void mergeShard(Shard *total, Shard *shard) {
+  for (int n = 0; n < shard->count; n++) {
+    Station *from = &shard->stations[n];
+    Station *to = findStation(total, from->pi, true, false);
+    if (!to) break;
+
+    if (from->freq) to->freq = from->freq;
+    to->groups += from->groups;
+    for (int t = 0; t < ANALYZE_TYPES; t++) to->types[t] += from->types[t];
+    mergeHistory(to->ps, to->psCount, from->ps, from->psCount);
+    mergeHistory(to->rt, to->rtCount, from->rt, from->rtCount);
+    if (from->ctCount) {
+      if (!to->ctCount) to->ctFirst = from->ctFirst;
+      to->ctLast = from->ctLast;
+      to->ctCount += from->ctCount;
+    }
+    delete from->rds;
+  }
+  total->groups += shard->groups;
+  total->frames += shard->frames;
+  total->crcErrors += shard->crcErrors;
+  total->lostSectors += shard->lostSectors;
+  total->noPI += shard->noPI;
+  total->bytes += shard->bytes;
+}  // mergeShard()
+
+
+static void printStation(Station *s) {
+  printf("station %04X", s->pi);
+  if (s->freq) printf("  %d.%02d MHz", s->freq / 100, s->freq % 100);
+  printf("  %llu groups\n", (unsigned long long)s->groups);
+
+  printf("  types:");
+  for (int t = 0; t < ANALYZE_TYPES; t++) {
+    if (s->types[t]) printf(" %d%c=%llu", t >> 1, (t & 1) ? 'B' : 'A', (unsigned long long)s->types[t]);
+  }
+  printf("\n");
+
+  for (uint8_t n = 0; n < s->psCount; n++) printf("  ps: '%s' (%u)\n", s->ps[n].text, s->ps[n].count);
+  for (uint8_t n = 0; n < s->rtCount; n++) printf("  rt: '%s' (%u)\n", s->rt[n].text, s->rt[n].count);
+  if (s->ctCount) {
+    printf("  ct: %u times, drift %+ld sec\n", s->ctCount, s->ctLast - s->ctFirst);
+  }
+}  // printStation()
+
+
+// ----- capture generator -----
+
+/// Stream that writes to a file.
+class FileStream : public Stream {
+public:
+  FileStream(FILE *f) { _f = f; };
+  int available() override { return (0); };
+  int read() override { return (-1); };
+  size_t write(const uint8_t *buffer, size_t size) override { return (fwrite(buffer, 1, size, _f)); };
+
+private:
+  FILE *_f;
+};  // FileStream
+
+
+// write a capture with 3 stations and groups every 87.6 msec.
+// A RadioFrames stream gets a status frame every 10 groups.
+static int writeCapture(const char *name, long groups, bool rdsLogFormat) {
+  FILE *f = fopen(name, "wb");
+  if (!f) {
+    perror(name);
+    return (1);
+  }
+
+  FileStream stream(f);
+  RADIO radio;
+  RadioFrames frames;
+  frames.begin(stream, radio);
+  RDSLog *rdsLog = new RDSLog();
+  if (rdsLogFormat) rdsLog->begin(0, "rdsanalyze");
+
+  const char *names[3] = { "ONE FM  ", "RADIO 2 ", "JAZZ 3  " };
+  char text[65];
+  uint8_t data[11];
+  uint32_t time = 0;
+
+  for (long n = 0; n < groups; n++) {
+    int station = (n / 4000) % 3;  // change the station every 4000 groups.
+    uint16_t pi = 0xD301 + station;
+    uint16_t freq = 8930 + 200 * station;
+    int seq = n % 28;  // 4 PS, 16 RT, 1 CT and 7 other groups
+    uint16_t b2, b3, b4;
+    uint8_t errors = 0;
+
+    time = (uint32_t)(n * 876 / 10);
+    if (rdsLogFormat) {
+      rdsLog->setFrequency(time, freq, RADIO_BAND_FM);
+    } else if (n % 10 == 0) {
+      memset(data, 0, sizeof(data));
+      data[0] = freq >> 8;
+      data[1] = freq & 0xFF;
+      data[7] = time >> 24;
+      data[8] = time >> 16;
+      data[9] = time >> 8;
+      data[10] = time;
+      frames.sendFrame(RADIOFRAME_STATUS, data, sizeof(data));
+    }
+
+    snprintf(text, sizeof(text), "Generated text number %-42ld", (n / 28) / 100);
+    if (seq < 4) {
+      b2 = (0x0 << 12) | seq;
+      b3 = 0xE0CD;
+      b4 = (names[station][2 * seq] << 8) | names[station][2 * seq + 1];
+    } else if (seq < 20) {
+      int s = seq - 4;
+      b2 = (0x2 << 12) | s;
+      b3 = (text[4 * s] << 8) | text[4 * s + 1];
+      b4 = (text[4 * s + 2] << 8) | text[4 * s + 3];
+    } else if (seq == 20) {
+      // clock time 12:00 + device time, 1 sec drift every 1000 groups on the second station.
+      long secs = 12 * 3600 + time / 1000 + ((station == 1) ? n / 1000 : 0);
+      uint16_t mins = (secs / 60) % 1440;
+      b2 = (0x4 << 12);
+      b3 = ((mins / 60) >> 4) & 0x01;
+      b4 = (((mins / 60) & 0x0F) << 12) | ((mins % 60) << 6);
+    } else {
+      static const uint8_t other[7] = { 1, 3, 5, 6, 7, 8, 10 };
+      b2 = (other[seq - 21] << 12);
+      b3 = b4 = 0;
+    }
+
+    if (n % 97 == 50) {
+      // a broken PI code marked as uncorrectable.
+      pi ^= 0x5A5A;
+      errors = RDS_PACKERRORS(RDS_ERRLEVEL_UNCORRECT, RDS_ERRLEVEL_NONE, RDS_ERRLEVEL_NONE, RDS_ERRLEVEL_NONE);
+    }
+
+    if (rdsLogFormat) {
+      rdsLog->addGroup(time, pi, b2, b3, b4, errors);
+      while (rdsLog->getSector()) {
+        stream.write(rdsLog->getSector(), RDSLOG_SECTORSIZE);
+        rdsLog->releaseSector();
+      }
+      continue;
+    }
+
+    data[0] = pi >> 8;
+    data[1] = pi & 0xFF;
+    data[2] = b2 >> 8;
+    data[3] = b2 & 0xFF;
+    data[4] = b3 >> 8;
+    data[5] = b3 & 0xFF;
+    data[6] = b4 >> 8;
+    data[7] = b4 & 0xFF;
+    data[8] = errors;
+    frames.sendFrame(RADIOFRAME_RDS, data, 9);
+  }  // for
+
+  if (rdsLogFormat) {
+    rdsLog->flush();
+    while (rdsLog->getSector()) {
+      stream.write(rdsLog->getSector(), RDSLOG_SECTORSIZE);
+      rdsLog->releaseSector();
+    }
+  }
+  delete rdsLog;
+  fclose(f);
+  return (0);
+}  // writeCapture()
+
+
+static void usage() {
+  fprintf(stderr, "usage: rdsanalyze [-j threads] [-q] file...\n");
+  fprintf(stderr, "       rdsanalyze -w file [-n groups] [-l]\n");
+}  // usage()
+
+
+int main(int argc, char *argv[]) {
+  int threads = std::thread::hardware_concurrency();
+  const char *writeName = nullptr;
+  long groups = 100000;
+  bool quiet = false;
+  bool rdsLogFormat = false;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "j:qw:n:l")) != -1) {
+    if (opt == 'j') threads = atoi(optarg);
+    else if (opt == 'q') quiet = true;
+    else if (opt == 'w') writeName = optarg;
+    else if (opt == 'n') groups = atol(optarg);
+    else if (opt == 'l') rdsLogFormat = true;
+    else {
+      usage();
+      return (2);
+    }
+  }  // while
+
+  if (writeName) return (writeCapture(writeName, groups, rdsLogFormat));
+
+  int files = argc - optind;
+  if (files < 1) {
+    usage();
+    return (2);
+  }
+  threads = constrain(threads, 1, files);
+
+  // every thread takes the next file until all are done.
+  Shard **shards = new Shard *[threads];
+  std::thread *workers = new std::thread[threads];
+  std::atomic<int> next(0);
+  std::atomic<bool> failed(false);
+  unsigned long start = micros();
+
+  for (int t = 0; t < threads; t++) {
+    shards[t] = new Shard();
+    workers[t] = std::thread([&, t]() {
+      int f;
+      while ((f = next++) < files) {
+        if (!mapFile(shards[t], argv[optind + f])) failed = true;
+      }
+    });
+  }
+
+  Shard *total = new Shard();
+  for (int t = 0; t < threads; t++) {
+    workers[t].join();
+    mergeShard(total, shards[t]);
+  }
+  unsigned long duration = max(micros() - start, 1UL);
+
+  if (!quiet) {
+    for (int n = 0; n < total->count; n++) printStation(&total->stations[n]);
+  }
+
+  printf("files:     %d (%d threads)\n", files, threads);
+  printf("bytes:     %llu\n", (unsigned long long)total->bytes);
+  printf("groups:    %llu (%llu frames or sectors, %llu crc errors, %llu lost sectors, %llu without PI)\n",
+         (unsigned long long)total->groups, (unsigned long long)total->frames,
+         (unsigned long long)total->crcErrors, (unsigned long long)total->lostSectors,
+         (unsigned long long)total->noPI);
+  printf("time:      %.3f sec\n", duration / 1e6);
+  printf("rate:      %.0f groups/sec\n", total->groups * 1e6 / duration);
+
+  for (int t = 0; t < threads; t++) delete shards[t];
+  delete[] shards;
+  delete[] workers;
+  delete total;
+  return (failed ? 1 : 0);
+}  // main()
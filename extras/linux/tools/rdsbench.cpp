@@ -0,0 +1,300 @@
+///
+/// \file rdsbench.cpp
+/// \brief Benchmark of the RDSParser on the host.
+///
+/// \author Matthias Hertel, http://www.mathertel.de
+/// \copyright Copyright (c) by Matthias Hertel.\n
+/// This work is licensed under a BSD 3-Clause license.\n
+/// See http://www.mathertel.de/License.aspx
+///
+/// \details
+/// Usage: rdsbench [-n groups] [-r repeat] [-f file.log]... [-s baseline] [-b baseline [-t percent]]
+///
+/// The synthetic streams of the BenchRDS example (clean, noisy, dynps, rtab, reset)
+/// and optionally recorded logs in the RDSLog format are passed through the RDSParser.
+///
+/// For every stream the tool reports:
+/// * ns/group: the time of processData(), the best of the repeated runs.
+/// * callbacks: the number of service name, text and time callbacks per 1000 groups.
+/// * changed: the bytes of the parser object that differ after a processData() call on average.
+///   Bytes written with an unchanged value are not counted.
+/// * heap: the bytes allocated on the heap while parsing, expected to be 0.
+/// * init ns: the time of a init() call as it is done on every retune.
+///
+/// The results can be saved as a baseline by -s.
+/// With -b the tool fails when the callbacks or changed bytes of a stream differ from the baseline
+/// or when memory was allocated. These values don't depend on the machine.
+/// The time is only compared when a threshold in percent is given by -t,
+/// this needs a baseline from the same machine.
+///
+/// History:
+/// --------
+/// * 18.10.2026 created.
+
+#include <fcntl.h>
+#include <malloc.h>
+#include <math.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <RDSParser.h>
+#include <RDSLog.h>
+#include <RDSBenchStreams.h>
+
+#define BENCH_STREAMS 16     ///< max. number of streams including the recorded logs.
+#define BENCH_INITLOOPS 10000
+#define BENCH_TOLERANCE 0.001  ///< allowed difference of the deterministic values from the baseline.
+
+/// A stream of groups in memory with the results.
+struct BenchStream {
+  char name[32];
+  RDSBENCH_GROUP *groups;
+  long count;
+
+  double nsGroup;
+  double callbacks;
+  double changedGroup;
+  long heap;
+  double nsInit;
+};
+
+static BenchStream streams[BENCH_STREAMS];
+static int streamCount = 0;
+
+static RDSParser rds;
+static long callbacks;
+
+
+static void countName(const char *) {
+  callbacks++;
+}
+static void countText(const char *) {
+  callbacks++;
+}
+static void countTime(uint8_t, uint8_t) {
+  callbacks++;
+}
+
+
+// the bytes allocated on the heap, mallinfo2() is available since glibc 2.33.
+static size_t heapUsed() {
+#if defined(__GLIBC__) && ((__GLIBC__ > 2) || (__GLIBC_MINOR__ >= 33))
+  return (mallinfo2().uordblks);
+#elif defined(__GLIBC__)
+  return ((unsigned)mallinfo().uordblks);
+#else
+  return (0);
+#endif
+}  // heapUsed()
+
+
+static double nowNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (ts.tv_sec * 1e9 + ts.tv_nsec);
+}  // nowNs()
+
+
+// generate a synthetic stream.
+static void addSynthetic(uint8_t scenario, long count) {
+  BenchStream *s = &streams[streamCount++];
+  RDSBenchStream gen;
+
+  strncpy(s->name, RDSBenchStream::name(scenario), sizeof(s->name) - 1);
+  s->groups = new RDSBENCH_GROUP[count];
+  s->count = count;
+  gen.begin(scenario);
+  for (long n = 0; n < count; n++) gen.next(&s->groups[n]);
+}  // addSynthetic()
+
+
+// load the groups of a log in the RDSLog format.
+static bool addRecorded(const char *fileName) {
+  struct stat st;
+  int fd = open(fileName, O_RDONLY);
+
+  if ((fd < 0) || (fstat(fd, &st) < 0) || (st.st_size < RDSLOG_SECTORSIZE)) {
+    perror(fileName);
+    return (false);
+  }
+  const uint8_t *data = (const uint8_t *)mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) return (false);
+
+  BenchStream *s = &streams[streamCount++];
+  const char *base = strrchr(fileName, '/');
+  strncpy(s->name, base ? base + 1 : fileName, sizeof(s->name) - 1);
+  s->groups = new RDSBENCH_GROUP[(st.st_size / RDSLOG_SECTORSIZE) * RDSLOG_RECORDS];
+  s->count = 0;
+
+  for (off_t pos = 0; pos + RDSLOG_SECTORSIZE <= st.st_size; pos += RDSLOG_SECTORSIZE) {
+    const uint8_t *sector = data + pos;
+    if ((sector[0] | (sector[1] << 8)) != RDSLOG_SECTORMAGIC) continue;
+
+    for (int r = 0; r < RDSLOG_RECORDS; r++) {
+      const uint8_t *p = sector + RDSLOG_SECTORHEADER + RDSLOG_RECORDSIZE * r;
+      if ((p[2] == RDSLOG_TAG_NONE) || (p[2] == RDSLOG_TAG_FREQ)) continue;
+      RDSBENCH_GROUP *g = &s->groups[s->count++];
+      g->errors = p[3];
+      g->block1 = p[4] | (p[5] << 8);
+      g->block2 = p[6] | (p[7] << 8);
+      g->block3 = p[8] | (p[9] << 8);
+      g->block4 = p[10] | (p[11] << 8);
+    }
+  }
+  munmap((void *)data, st.st_size);
+  return (s->count > 0);
+}  // addRecorded()
+
+
+static void runStream(BenchStream *s, int repeat) {
+  static uint8_t before[sizeof(RDSParser)];
+  double best = 1e30;
+
+  // timing, the best of the runs.
+  for (int r = 0; r < repeat; r++) {
+    rds.init();
+    callbacks = 0;
+    size_t heap = heapUsed();
+    double start = nowNs();
+    for (long n = 0; n < s->count; n++) {
+      RDSBENCH_GROUP *g = &s->groups[n];
+      rds.processData(g->block1, g->block2, g->block3, g->block4, g->errors);
+    }
+    double ns = (nowNs() - start) / s->count;
+    s->heap = (long)(heapUsed() - heap);
+    if (ns < best) best = ns;
+  }
+  s->nsGroup = best;
+  s->callbacks = 1000.0 * callbacks / s->count;
+
+  // changed bytes of the parser object, not timed.
+  uint64_t changed = 0;
+  rds.init();
+  for (long n = 0; n < s->count; n++) {
+    RDSBENCH_GROUP *g = &s->groups[n];
+    memcpy(before, (void *)&rds, sizeof(RDSParser));
+    rds.processData(g->block1, g->block2, g->block3, g->block4, g->errors);
+    const uint8_t *after = (const uint8_t *)(void *)&rds;
+    for (size_t i = 0; i < sizeof(RDSParser); i++) changed += (before[i] != after[i]);
+  }
+  s->changedGroup = (double)changed / s->count;
+
+  double start = nowNs();
+  for (int n = 0; n < BENCH_INITLOOPS; n++) rds.init();
+  s->nsInit = (nowNs() - start) / BENCH_INITLOOPS;
+}  // runStream()
+
+
+static void saveBaseline(const char *fileName) {
+  FILE *f = fopen(fileName, "w");
+  if (!f) {
+    perror(fileName);
+    return;
+  }
+  fprintf(f, "# stream ns/group callbacks changed\n");
+  for (int n = 0; n < streamCount; n++) {
+    BenchStream *s = &streams[n];
+    fprintf(f, "%s %.2f %.3f %.3f\n", s->name, s->nsGroup, s->callbacks, s->changedGroup);
+  }
+  fclose(f);
+}  // saveBaseline()
+
+
+// compare with the baseline, returns the number of regressions.
+// The time is only compared with a threshold >= 0.
+static int checkBaseline(const char *fileName, double threshold) {
+  char line[120], name[32];
+  double ns, cb, changed;
+  int regressions = 0;
+  FILE *f = fopen(fileName, "r");
+
+  if (!f) {
+    perror(fileName);
+    return (1);
+  }
+  while (fgets(line, sizeof(line), f)) {
+    if ((line[0] == '#') || (sscanf(line, "%31s %lf %lf %lf", name, &ns, &cb, &changed) != 4)) continue;
+    for (int n = 0; n < streamCount; n++) {
+      BenchStream *s = &streams[n];
+      if (strcmp(s->name, name) != 0) continue;
+
+      bool bad = (fabs(s->callbacks - cb) > BENCH_TOLERANCE);
+      printf("%-12s %8.3f callbacks, baseline %8.3f: %s\n", name, s->callbacks, cb, bad ? "CHANGED" : "ok");
+      regressions += bad;
+
+      bad = (fabs(s->changedGroup - changed) > BENCH_TOLERANCE);
+      printf("%-12s %8.3f changed, baseline %8.3f: %s\n", name, s->changedGroup, changed, bad ? "CHANGED" : "ok");
+      regressions += bad;
+
+      if (threshold >= 0) {
+        double change = 100.0 * (s->nsGroup - ns) / ns;
+        bad = (change > threshold);
+        printf("%-12s %8.2f ns/group, baseline %8.2f: %+6.1f%% %s\n", name, s->nsGroup, ns, change, bad ? "REGRESSION" : "ok");
+        regressions += bad;
+      }
+    }
+  }
+  fclose(f);
+  return (regressions);
+}  // checkBaseline()
+
+
+static void usage() {
+  fprintf(stderr, "usage: rdsbench [-n groups] [-r repeat] [-f file.log]... [-s baseline] [-b baseline [-t percent]]\n");
+}  // usage()
+
+
+int main(int argc, char *argv[]) {
+  long groups = 100000;
+  int repeat = 5;
+  const char *saveName = nullptr;
+  const char *baseName = nullptr;
+  double threshold = -1;  // no time check.
+  int opt;
+
+  // the options for the size must be known before the streams are created.
+  while ((opt = getopt(argc, argv, "n:r:f:s:b:t:")) != -1) {
+    if (opt == 'n') groups = max(atol(optarg), (long)RDSBENCH_CYCLE);
+    else if (opt == 'r') repeat = max(atoi(optarg), 1);
+    else if (opt == 's') saveName = optarg;
+    else if (opt == 'b') baseName = optarg;
+    else if (opt == 't') threshold = atof(optarg);
+    else if (opt != 'f') {
+      usage();
+      return (2);
+    }
+  }  // while
+
+  for (uint8_t s = 0; s < RDSBENCH_SCENARIOS; s++) addSynthetic(s, groups);
+
+  optind = 1;
+  while ((opt = getopt(argc, argv, "n:r:f:s:b:t:")) != -1) {
+    if ((opt == 'f') && (streamCount < BENCH_STREAMS) && (!addRecorded(optarg))) return (2);
+  }
+
+  rds.attachServiceNameCallback(countName);
+  rds.attachTextCallback(countText);
+  rds.attachTimeCallback(countTime);
+
+  printf("%-12s %10s %10s %10s %10s %8s %8s\n", "stream", "groups", "ns/group", "callbacks", "changed", "heap", "init ns");
+  bool allocated = false;
+  for (int n = 0; n < streamCount; n++) {
+    BenchStream *s = &streams[n];
+    runStream(s, repeat);
+    printf("%-12s %10ld %10.2f %10.1f %10.1f %8ld %8.1f\n", s->name, s->count, s->nsGroup, s->callbacks, s->changedGroup, s->heap, s->nsInit);
+    allocated |= (s->heap != 0);
+  }
+  printf("# sizeof(RDSParser)=%u, callbacks per 1000 groups, bytes of the parser changed per group\n", (unsigned)sizeof(RDSParser));
+
+  if (saveName) saveBaseline(saveName);
+
+  int result = 0;
+  if (allocated) {
+    printf("memory was allocated while parsing.\n");
+    result = 1;
+  }
+  if ((baseName) && (checkBaseline(baseName, threshold) > 0)) result = 1;
+  return (result);
+}  // main()
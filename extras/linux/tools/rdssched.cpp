@@ -0,0 +1,233 @@
+///
+/// \file rdssched.cpp
+/// \brief Host simulation of the adaptive RDS poll scheduler of the RADIO class.
+///
+/// \author Matthias Hertel, http://www.mathertel.de
+/// \copyright Copyright (c) by Matthias Hertel.\n
+/// This work is licensed under a BSD 3-Clause license.\n
+/// See http://www.mathertel.de/License.aspx
+///
+/// \details
+/// Usage: rdssched [-n groups] [-d drop] [-p phase] [-l loop] [-j jitter] [-g gap] [-a]
+///
+/// A RDA5807M on a RadioFakeBus receives RDS groups every 87.58 msec (104 bits at 1187.5 bit/sec)
+/// in a simulated time. The main loop calls checkRDS() every loop usec. plus a random jitter.
+/// A group that is not read before the next one arrives is lost.
+///
+/// * -n is the number of groups sent by the station, default is 2000.
+/// * -d drops every n-th group in the chip like a group with sync errors, default is 7, 0 = none.
+/// * -p is the arrival time of the first group in usec. after tuning, default is 31700.
+/// * -l is the time of one loop in usec., default is 1000.
+/// * -j is the max. random jitter added to a loop in usec., default is 500.
+/// * -g stops RDS for the given msec. in the middle of the groups and then continues with another phase.
+/// * -a polls the chip in every loop (RADIO_RDSPOLL_ALWAYS) for comparison.
+///
+/// The exit code is 1 when groups were lost or delivered twice while the phase was tracked.
+/// Groups lost after a gap until the first group is received again are reported separately
+/// together with the time it took.
+///
+/// History:
+/// --------
+/// * 18.10.2026 created.
+
+#include <unistd.h>
+
+#include <radio.h>
+#include <RDA5807M.h>
+
+#include "RadioFakeBus.h"
+
+#define SIM_GROUPTIME (104 * 1000000.0 / 1187.5)  // usec. per group, not rounded like the scheduler.
+
+#define SIM_ADDRESS 0x10  // address for the sequential access of the registers 0A...0F.
+
+// ----- the simulated chip -----
+
+static uint32_t simGroups = 2000;  ///< number of groups sent by the station.
+static uint32_t simDrop = 7;       ///< every n-th group is dropped by the chip.
+static uint32_t simGapFrom = 0;    ///< first group of the gap.
+static uint32_t simGapTo = 0;      ///< first group after the gap.
+static double simGapShift = 0;     ///< shift of the phase after the gap in usec.
+static double simStart = 0;        ///< arrival of group 0 in usec.
+
+static uint32_t simNext = 0;       ///< next group sent by the station.
+static bool simPending = false;    ///< a group is in the registers and not read yet.
+static uint16_t simGroup = 0;      ///< the group in the registers.
+
+static bool simAcquire = false;      ///< no group was received since the gap.
+static uint64_t simGapEnd = 0;       ///< arrival of the first group after the gap.
+static uint64_t simAcquireTime = 0;  ///< usec. from the end of the gap to the first received group.
+
+static uint32_t simLost = 0;         ///< groups lost while tracking.
+static uint32_t simLostGap = 0;      ///< groups lost after the gap until the first received group.
+static uint32_t simDropped = 0;      ///< groups dropped by the chip.
+static uint32_t simReceived = 0;     ///< groups passed to the RDS callback.
+static uint32_t simDoubles = 0;      ///< groups passed to the RDS callback twice.
+static uint32_t simPolls = 0;        ///< number of register reads.
+static int32_t simLastGroup = -1;    ///< last group passed to the RDS callback.
+
+
+// arrival time of a group in usec.
+static uint64_t simArrival(uint32_t n) {
+  double t = simStart + n * SIM_GROUPTIME;
+  if ((simGapTo) && (n >= simGapTo)) t += simGapShift;
+  return ((uint64_t)t);
+}  // simArrival()
+
+
+// let all groups arrive until the current time.
+static void simUpdate() {
+  while ((simNext < simGroups) && (simArrival(simNext) <= _linuxSimTime)) {
+    uint32_t n = simNext++;
+
+    if ((simGapTo) && (n == simGapTo)) {
+      // the first group after the gap.
+      simGapEnd = simArrival(n);
+      simAcquire = true;
+    }
+
+    if ((n >= simGapFrom) && (n < simGapTo)) {
+      // no RDS.
+    } else if ((simDrop) && (n % simDrop == simDrop - 1)) {
+      simDropped++;
+    } else {
+      if (simPending) {
+        if (simAcquire) simLostGap++;
+        else simLost++;
+      }
+      simPending = true;
+      simGroup = n;
+    }
+  }  // while
+}  // simUpdate()
+
+
+// simulate the registers 0A...0F of the RDA5807M, all other transfers are accepted.
+static int simHandler(uint8_t address, const uint8_t *, int, uint8_t *data, int len) {
+  if ((address != SIM_ADDRESS) || (!data) || (len <= 0)) return (0);
+
+  simUpdate();
+  simPolls++;
+
+  uint16_t regs[6];
+  memset(regs, 0, sizeof(regs));
+  regs[0] = 0x0400;  // stereo
+  if (simNext > 0) regs[0] |= 0x1000;  // RDS synchronized with the first group
+  regs[1] = (40 << 10) | 0x0100;  // rssi, FM true
+
+  if (simPending) {
+    regs[0] |= 0x8000;  // new group ready
+    regs[2] = 0xD302;
+    regs[3] = 0x0000;
+    regs[4] = 0xE000;
+    regs[5] = simGroup;
+  }
+
+  for (int n = 0; (n < 6) && (2 * n + 1 < len); n++) {
+    data[2 * n] = regs[n] >> 8;
+    data[2 * n + 1] = regs[n] & 0xFF;
+  }
+
+  // the group is read together with the status.
+  if (len >= 12) simPending = false;
+  return (len);
+}  // simHandler()
+
+
+// count the groups passed by the library.
+static void simReceive(uint16_t, uint16_t, uint16_t, uint16_t block4, uint8_t) {
+  if (simAcquire) {
+    simAcquireTime = _linuxSimTime - simGapEnd;
+    simAcquire = false;
+  }
+
+  if ((int32_t)block4 == simLastGroup) simDoubles++;
+  simLastGroup = block4;
+  simReceived++;
+}  // simReceive()
+
+
+static void usage() {
+  fprintf(stderr, "usage: rdssched [-n groups] [-d drop] [-p phase] [-l loop] [-j jitter] [-g gap] [-a]\n");
+}  // usage()
+
+
+int main(int argc, char *argv[]) {
+  unsigned long phase = 31700;
+  unsigned long loop = 1000;
+  unsigned long jitter = 500;
+  unsigned long gap = 0;
+  bool always = false;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "n:d:p:l:j:g:a")) != -1) {
+    if (opt == 'n') simGroups = strtoul(optarg, nullptr, 10);
+    else if (opt == 'd') simDrop = strtoul(optarg, nullptr, 10);
+    else if (opt == 'p') phase = strtoul(optarg, nullptr, 10);
+    else if (opt == 'l') loop = strtoul(optarg, nullptr, 10);
+    else if (opt == 'j') jitter = strtoul(optarg, nullptr, 10);
+    else if (opt == 'g') gap = strtoul(optarg, nullptr, 10);
+    else if (opt == 'a') always = true;
+    else {
+      usage();
+      return (2);
+    }
+  }  // while
+
+  if ((simGroups == 0) || (loop == 0)) {
+    usage();
+    return (2);
+  }
+
+  // the simulated time starts at 1 sec.
+  _linuxSimTime = 1000000;
+  _linuxSimulated = true;
+  srand(1);
+
+  RDA5807M radio;
+  RadioFakeBus bus;
+  bus.addDevice(0x10);
+  bus.addDevice(0x11);
+
+  if (!radio.initBus(bus)) {
+    fprintf(stderr, "rdssched: no rda5807m found on fake bus.\n");
+    return (1);
+  }
+  if (always) radio.setup(RADIO_RDSPOLL, RADIO_RDSPOLL_ALWAYS);
+  radio.setBandFrequency(RADIO_BAND_FM, 8930);
+  radio.attachReceiveRDSExt(simReceive);
+
+  // the station starts sending after tuning.
+  simStart = _linuxSimTime + phase;
+
+  if (gap) {
+    // the gap is in the middle and the groups continue with a phase of 1/3 group.
+    simGapFrom = simGroups / 2;
+    simGapTo = simGapFrom + (uint32_t)(gap * 1000 / SIM_GROUPTIME) + 1;
+    simGapShift = SIM_GROUPTIME / 3;
+    if (simGapTo >= simGroups) simGroups = simGapTo + 100;
+  }
+
+  bus.attachHandler(simHandler);
+
+  uint64_t end = simArrival(simGroups) + 1000;
+  while (_linuxSimTime < end) {
+    radio.checkRDS();
+    _linuxSimTime += loop;
+    if (jitter) _linuxSimTime += rand() % jitter;
+  }  // while
+
+  uint32_t sent = simGroups - (simGapTo - simGapFrom);
+  printf("mode:      %s\n", always ? "always" : "adaptive");
+  printf("groups:    %u (%u dropped by the chip)\n", sent, simDropped);
+  printf("received:  %u\n", simReceived);
+  printf("lost:      %u\n", simLost);
+  printf("doubles:   %u\n", simDoubles);
+  printf("polls:     %u (%.2f per group)\n", simPolls, (double)simPolls / sent);
+  if (gap) {
+    printf("gap:       %lu msec, %u lost, %lu msec until the first group\n",
+           gap, simLostGap, (unsigned long)(simAcquireTime / 1000));
+  }
+
+  return ((simLost || simDoubles) ? 1 : 0);
+}  // main()
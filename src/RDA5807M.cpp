@@ -14,6 +14,9 @@
 /// History:
 /// --------
 /// * 05.08.2014 created.
+/// * 18.10.2026 RDS groups are passed with the block error levels from register 0x0B.
+/// * 18.10.2026 combined status and RDS read with a short living cache.
+/// * 18.10.2026 RDS polling by the adaptive scheduler.
 
 
 #include <Arduino.h>
@@ -64,6 +67,7 @@
 
 #define RADIO_REG_RA 0x0A
 #define RADIO_REG_RA_RDS 0x8000
+#define RADIO_REG_RA_RDSS 0x1000
 #define RADIO_REG_RA_RDSBLOCK 0x0800
 #define RADIO_REG_RA_STEREO 0x0400
 #define RADIO_REG_RA_NR 0x03FF
@@ -71,6 +75,8 @@
 #define RADIO_REG_RB 0x0B
 #define RADIO_REG_RB_FMTRUE 0x0100
 #define RADIO_REG_RB_FMREADY 0x0080
+#define RADIO_REG_RB_BLERA 0x000C
+#define RADIO_REG_RB_BLERB 0x0003
 
 
 #define RADIO_REG_RDSA 0x0C
@@ -84,6 +90,9 @@
 // I2C-Address RDA Chip for Index  Access
 #define I2C_INDX 0x11
 
+// time in msec the status registers in memory are used without reading again.
+#define RDA5807M_STATUS_CACHE 20
+
 
 // ----- implement
 
@@ -100,10 +109,8 @@ bool RDA5807M::init() {
 
   RADIO::init();  // will create reset impulse
 
-  _i2cPort->begin();
-  _i2cPort->beginTransmission(I2C_INDX);
-  result = _i2cPort->endTransmission();
-  if (result != 0) {
+  _bus->begin();
+  if (!_wireExists(_bus, I2C_INDX)) {
     DEBUG_STR("NO radio found.");
 
   } else {
@@ -230,8 +237,7 @@ void RDA5807M::setBand(RADIO_BAND newBand) {
 // retrieve the real frequency from the chip after automatic tuning.
 RADIO_FREQ RDA5807M::getFrequency() {
   // check register A
-  _i2cPort->requestFrom(I2C_SEQ, 2);
-  registers[RADIO_REG_RA] = _read16HL(_i2cPort);
+  _readStatus();
 
   uint16_t ch = registers[RADIO_REG_RA] & RADIO_REG_RA_NR;
 
@@ -298,33 +304,66 @@ void RDA5807M::seekDown(bool toNextSender) {
 // registers 0A through 0F
 // using the sequential read access mode.
 void RDA5807M::_readRegisters() {
-  _i2cPort->requestFrom(I2C_SEQ, (6 * 2));
+  uint8_t data[6 * 2];
+
+  _bus->transfer(I2C_SEQ, nullptr, 0, data, sizeof(data));
   for (int i = 0; i < 6; i++) {
-    registers[0xA + i] = _read16HL(_i2cPort);
+    registers[0xA + i] = _read16HL(data + 2 * i);
   }
 }  // _readRegisters()
 
 
+// Load the status registers using the sequential read access mode that always starts at register 0A.
+// With force, used by checkRDS(), the registers 0A and 0B and the RDS registers 0C through 0F
+// are read in one transaction so a group signaled by RDSR in the same read is never missed.
+// getFrequency() and getRadioInfo() only read 0A and 0B or use the status cached within RDA5807M_STATUS_CACHE.
+// A group stays pending until checkRDS() forwards it.
+// Returns true when a group is pending.
+bool RDA5807M::_readStatus(bool force) {
+  unsigned long now = millis();
+
+  if ((!force) && (_statusValid) && (now - _statusTime < RDA5807M_STATUS_CACHE)) {
+    return (_rdsPending);
+  }
+
+  uint8_t data[6 * 2];
+  int cnt = force ? 6 : 2;
+  _bus->transfer(I2C_SEQ, nullptr, 0, data, 2 * cnt);
+  for (int i = 0; i < cnt; i++) {
+    registers[RADIO_REG_RA + i] = _read16HL(data + 2 * i);
+  }
+  if ((force) && (registers[RADIO_REG_RA] & RADIO_REG_RA_RDS)) {
+    _rdsPending = true;
+  }
+
+  _statusTime = now;
+  _statusValid = true;
+  return (_rdsPending);
+}  // _readStatus()
+
+
 // Save writable registers back to the chip
 // The registers 02 through 06, containing the configuration
 // using the sequential write access mode.
 void RDA5807M::_saveRegisters() {
   DEBUG_FUNC0("saveRegisters");
-  _i2cPort->beginTransmission(I2C_SEQ);
+  _statusValid = false;
+  uint8_t data[5 * 2];
   for (int i = 2; i <= 6; i++)
-    _write16HL(_i2cPort, registers[i]);
-  _i2cPort->endTransmission();
+    _write16HL(data + 2 * (i - 2), registers[i]);
+  _bus->transfer(I2C_SEQ, data, sizeof(data), nullptr, 0);
 }  // _saveRegisters
 
 
 // Save one register back to the chip
 void RDA5807M::_saveRegister(byte regNr) {
   DEBUG_FUNC2X("saveRegister", regNr, registers[regNr]);
+  _statusValid = false;
 
-  _i2cPort->beginTransmission(I2C_INDX);
-  _i2cPort->write(regNr);
-  _write16HL(_i2cPort, registers[regNr]);
-  _i2cPort->endTransmission();
+  uint8_t data[3];
+  data[0] = regNr;
+  _write16HL(data + 1, registers[regNr]);
+  _bus->transfer(I2C_INDX, data, sizeof(data), nullptr, 0);
 }  // _saveRegister
 
 
@@ -355,61 +394,34 @@ void RDA5807M::_saveRegister(byte regNr) {
 void RDA5807M::checkRDS() {
   // DEBUG_FUNC0("checkRDS");
 
-  // check RDS data if there is a listener !
-  if (_sendRDS) {
+  // check RDS data if there is a listener and polling is due !
+  if (((_sendRDS) || (_sendRDSExt)) && (_rdsPollDue())) {
 
-    // check register A
-    _i2cPort->requestFrom(I2C_SEQ, 2);
-    registers[RADIO_REG_RA] = _read16HL(_i2cPort);
+    // read status, signal and RDS blocks at once. This status is also used by getRadioInfo() and getFrequency().
+    bool result = _readStatus(true);
+    _rdsPollDone(result);
 
     // if (registers[RADIO_REG_RA] & RADIO_REG_RA_RDSBLOCK) {
     // DEBUG_STR("BLOCK_E found.");
     // }  // if
 
-    if (registers[RADIO_REG_RA] & RADIO_REG_RA_RDS) {
-      // check for new RDS data available
-      uint16_t newData;
-      bool result = false;
-
-      _i2cPort->beginTransmission(I2C_INDX);  // Device 0x11 for random access
-      _i2cPort->write(RADIO_REG_RDSA);        // Start at Register 0x0C
-      _i2cPort->endTransmission(0);           // restart condition
-
-      _i2cPort->requestFrom(I2C_INDX, 8, 1);  // Retransmit device address with READ, followed by 8 bytes
-      newData = _read16HL(_i2cPort);
-      if (newData != registers[RADIO_REG_RDSA]) {
-        registers[RADIO_REG_RDSA] = newData;
-        result = true;
-      }
-
-      newData = _read16HL(_i2cPort);
-      if (newData != registers[RADIO_REG_RDSB]) {
-        registers[RADIO_REG_RDSB] = newData;
-        result = true;
-      }
-
-      newData = _read16HL(_i2cPort);
-      if (newData != registers[RADIO_REG_RDSC]) {
-        registers[RADIO_REG_RDSC] = newData;
-        result = true;
-      }
-
-      newData = _read16HL(_i2cPort);
-      if (newData != registers[RADIO_REG_RDSD]) {
-        registers[RADIO_REG_RDSD] = newData;
-        result = true;
-      }
-
+    if (result) {
       // _printHex(registers[RADIO_REG_RDSA]); _printHex(registers[RADIO_REG_RDSB]);
       // _printHex(registers[RADIO_REG_RDSC]); _printHex(registers[RADIO_REG_RDSD]);
       // Serial.println();
 
-      if (result) {
-        // new data in the registers
-        // send to RDS decoder
-        _sendRDS(registers[RADIO_REG_RDSA], registers[RADIO_REG_RDSB], registers[RADIO_REG_RDSC], registers[RADIO_REG_RDSD]);
-      }  // if
-    }    // if
+      // a new group in the registers, also when it is equal to the last one.
+      _rdsPending = false;
+
+      // The chip only reports errors for block A and B, assume the worse one for block C and D.
+      uint8_t errA = (registers[RADIO_REG_RB] & RADIO_REG_RB_BLERA) >> 2;
+      uint8_t errB = (registers[RADIO_REG_RB] & RADIO_REG_RB_BLERB);
+      uint8_t errCD = max(errA, errB);
+
+      // send to RDS decoder
+      _receiveRDS(registers[RADIO_REG_RDSA], registers[RADIO_REG_RDSB], registers[RADIO_REG_RDSC], registers[RADIO_REG_RDSD],
+                  RDS_PACKERRORS(errA, errB, errCD, errCD));
+    }  // if
   }
 }
 
@@ -419,8 +431,8 @@ void RDA5807M::getRadioInfo(RADIO_INFO *info) {
 
   RADIO::getRadioInfo(info);
 
-  // read data from registers A .. F of the chip into class memory
-  _readRegisters();
+  // use the status of the last RDS poll or read registers A and B of the chip into class memory
+  _readStatus();
   info->active = true;  // ???
   if (registers[RADIO_REG_RA] & RADIO_REG_RA_STEREO) info->stereo = true;
   if (registers[RADIO_REG_RA] & RADIO_REG_RA_RDS) info->rds = true;
@@ -486,12 +498,12 @@ void RDA5807M::debugStatus() {
   Serial.println();
 
   // registers
-  _i2cPort->beginTransmission(I2C_INDX);   // Device 0x11 for random access
-  _i2cPort->write(0x00);                   // Start at Register 0x0C
-  _i2cPort->endTransmission(0);            // restart condition
-  _i2cPort->requestFrom(I2C_INDX, 32, 1);  // Retransmit device address with READ, followed by 8 bytes
+  // Device 0x11 for random access starting at register 0x00, read all 16 registers after a repeated start.
+  uint8_t reg = 0x00;
+  uint8_t data[16 * 2];
+  _bus->transferRestart(I2C_INDX, &reg, 1, data, sizeof(data));
   for (int n = 0; n < 16; n++) {
-    _printHex4(_read16HL(_i2cPort));
+    _printHex4(_read16HL(data + 2 * n));
   }
   Serial.println();
 
@@ -17,6 +17,7 @@
 /// * 12.05.2014 creation of the RDA5807M library.
 /// * 28.06.2014 running simple radio
 /// * 08.07.2014 RDS data receive function can be registered.
+/// * 18.10.2026 status and RDS data are read in one transaction and cached.
 
 // multi-Band enabled
 
@@ -77,9 +78,20 @@ protected:
   // ----- local variables
   uint16_t registers[16];  // memory representation of the registers
 
+  unsigned long _statusTime = 0;  ///< time in millis when the status registers were read.
+  bool _statusValid = false;      ///< the status registers in memory are valid.
+  bool _rdsPending = false;       ///< a RDS group was read but not forwarded by checkRDS().
+
   // ----- low level communication to the chip using I2C bus
 
   void _readRegisters();           // read all status & data registers
+
+  /**
+   * Read the status registers RA and RB and when RDS is synchronized the RDS blocks in one transaction.
+   * @param force read even when the cached status is still valid.
+   * @return true when new RDS block data was received.
+   */
+  bool _readStatus(bool force = false);
   void _saveRegisters();           // Save writable registers back to the chip
   void _saveRegister(byte regNr);  // Save one register back to the chip
 
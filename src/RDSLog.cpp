@@ -0,0 +1,179 @@
+///
+/// \file RDSLog.cpp
+/// \brief Binary log format for RDS groups and a recorder writing whole sectors.
+///
+/// \author Matthias Hertel, http://www.mathertel.de
+/// \copyright Copyright (c) by Matthias Hertel.\n
+/// This work is licensed under a BSD 3-Clause license.\n
+/// See http://www.mathertel.de/License.aspx
+///
+/// \details
+/// See RDSLog.h for the format and the usage.
+///
+/// More documentation and source code is available at http://www.mathertel.de/Arduino
+///
+/// History:
+/// --------
+/// * 18.10.2026 created.
+
+#include "RDSLog.h"
+
+// store values in Low-High byte order
+static void _put16(uint8_t *p, uint16_t v) {
+  p[0] = (uint8_t)(v);
+  p[1] = (uint8_t)(v >> 8);
+}
+
+static void _put32(uint8_t *p, uint32_t v) {
+  _put16(p, (uint16_t)v);
+  _put16(p + 2, (uint16_t)(v >> 16));
+}
+
+
+RDSLog::RDSLog() {
+  _first = 0;
+  _full = 0;
+  _open = false;
+  _record = 0;
+  _sequence = 0;
+  _last = 0;
+  _tag = RDSLOG_TAG_LAST;
+  _freq = 0;
+  _band = RADIO_BAND_NONE;
+  dropped = 0;
+}  // RDSLog()
+
+
+void RDSLog::begin(unsigned long now, const char *source) {
+  _first = 0;
+  _full = 0;
+  _open = false;
+  _record = 0;
+  _sequence = 0;
+  _last = now;
+  _tag = RDSLOG_TAG_LAST;
+  _freq = 0;
+  _band = RADIO_BAND_NONE;
+  dropped = 0;
+
+  // the file header is the first sector.
+  uint8_t *h = _buffer[0];
+  memset(h, 0, RDSLOG_SECTORSIZE);
+  memcpy(h, "RDSLOG", 6);
+  _put16(h + 8, RDSLOG_VERSION);
+  _put16(h + 10, RDSLOG_SECTORSIZE);
+  _put16(h + 12, RDSLOG_RECORDSIZE);
+  _put16(h + 14, RDSLOG_RECORDS);
+  _put32(h + 16, now);
+  strncpy((char *)h + 20, source, 16);
+  _full = 1;
+}  // begin()
+
+
+void RDSLog::setFrequency(unsigned long now, RADIO_FREQ freq, RADIO_BAND band) {
+  if ((freq == _freq) && (band == _band)) return;
+  _freq = freq;
+  _band = band;
+
+  if ((band == RADIO_BAND_FM) && (freq >= 8750) && ((freq - 8750) % 10 == 0) && ((freq - 8750) / 10 <= RDSLOG_TAG_MAX)) {
+    _tag = (freq - 8750) / 10;
+
+  } else {
+    // a control record for frequencies without a tag.
+    // When it is dropped it is written before the next group.
+    _tag = RDSLOG_TAG_FREQ;
+    _writeFrequency(now);
+  }
+}  // setFrequency()
+
+
+// Write the control record, the following groups are tagged by RDSLOG_TAG_LAST.
+bool RDSLog::_writeFrequency(unsigned long now) {
+  uint8_t *r = _startRecord(now);
+  if (!r) return (false);
+
+  r[2] = RDSLOG_TAG_FREQ;
+  r[3] = 0;
+  _put16(r + 4, _freq);
+  _put16(r + 6, _band);
+  _put32(r + 8, 0);
+  if (_record == RDSLOG_RECORDS) _closeSector();
+  _tag = RDSLOG_TAG_LAST;
+  return (true);
+}  // _writeFrequency()
+
+
+bool RDSLog::addGroup(unsigned long now, uint16_t block1, uint16_t block2, uint16_t block3, uint16_t block4, uint8_t errors) {
+  if ((_tag == RDSLOG_TAG_FREQ) && (!_writeFrequency(now))) return (false);
+
+  uint8_t *r = _startRecord(now);
+  if (!r) return (false);
+
+  r[2] = _tag;
+  r[3] = errors;
+  _put16(r + 4, block1);
+  _put16(r + 6, block2);
+  _put16(r + 8, block3);
+  _put16(r + 10, block4);
+  if (_record == RDSLOG_RECORDS) _closeSector();
+  return (true);
+}  // addGroup()
+
+
+void RDSLog::flush() {
+  if (_open) _closeSector();
+}  // flush()
+
+
+const uint8_t *RDSLog::getSector() {
+  return ((_full) ? _buffer[_first] : NULL);
+}  // getSector()
+
+
+void RDSLog::releaseSector() {
+  if (_full) {
+    _first = (_first + 1) % RDSLOG_BUFFERS;
+    _full--;
+  }
+}  // releaseSector()
+
+
+// Get the next record in the sector that is filled and set the time.
+// A new sector is started when needed and a buffer is free.
+uint8_t *RDSLog::_startRecord(unsigned long now) {
+  // the time delta of a record is limited to 16 bits.
+  if ((_open) && (now - _last > 0xFFFF)) _closeSector();
+
+  if (!_open) {
+    if (_full == RDSLOG_BUFFERS) {
+      dropped++;
+      return (NULL);
+    }
+    uint8_t *s = _buffer[(_first + _full) % RDSLOG_BUFFERS];
+    _put16(s, RDSLOG_SECTORMAGIC);
+    _put16(s + 2, _sequence++);
+    _put32(s + 4, now);
+    _open = true;
+    _record = 0;
+    _last = now;
+  }
+
+  uint8_t *r = _buffer[(_first + _full) % RDSLOG_BUFFERS] + RDSLOG_SECTORHEADER + RDSLOG_RECORDSIZE * _record;
+  _put16(r, (uint16_t)(now - _last));
+  _last = now;
+  _record++;
+  return (r);
+}  // _startRecord()
+
+
+// Fill the unused records and pass the sector to be written.
+void RDSLog::_closeSector() {
+  uint8_t *s = _buffer[(_first + _full) % RDSLOG_BUFFERS];
+  for (uint8_t n = _record; n < RDSLOG_RECORDS; n++) {
+    uint8_t *r = s + RDSLOG_SECTORHEADER + RDSLOG_RECORDSIZE * n;
+    memset(r, 0, RDSLOG_RECORDSIZE);
+    r[2] = RDSLOG_TAG_NONE;
+  }
+  _open = false;
+  _full++;
+}  // _closeSector()
@@ -0,0 +1,137 @@
+///
+/// \file RDSLog.h
+/// \brief Binary log format for RDS groups and a recorder writing whole sectors.
+///
+/// \author Matthias Hertel, http://www.mathertel.de
+/// \copyright Copyright (c) by Matthias Hertel.\n
+/// This work is licensed under a BSD 3-Clause license.\n
+/// See http://www.mathertel.de/License.aspx
+///
+/// \details
+/// A log file is a sequence of 512 byte sectors so it can be written to SD cards
+/// by whole sectors without reading and merging existing data.
+/// All values are stored in Low-High byte order.
+///
+/// The first sector is the file header:
+///
+/// Offset    | Content
+/// :-------- | :------------------------------------------------------
+/// 0         | Magic "RDSLOG" followed by 2 zero bytes
+/// 8         | Version of the format (16 bit), RDSLOG_VERSION
+/// 10        | Sector size (16 bit), 512
+/// 12        | Record size (16 bit), 12
+/// 14        | Records per sector (16 bit), 42
+/// 16        | Device time of the start in msec (32 bit)
+/// 20        | Source name, 16 chars, zero padded
+/// 36...511  | zero
+///
+/// Every following sector starts with a sector header and contains 42 records:
+///
+/// Offset    | Content
+/// :-------- | :------------------------------------------------------
+/// 0         | Magic 0x4C52 ("RL") (16 bit)
+/// 2         | Sequence number of the sector starting with 0 (16 bit)
+/// 4         | Device time in msec the deltas of the records start from (32 bit)
+/// 8...511   | 42 records with 12 bytes
+///
+/// A record is:
+///
+/// Offset    | Content
+/// :-------- | :------------------------------------------------------
+/// 0         | Time in msec since the previous record or the sector time (16 bit)
+/// 2         | Frequency tag: (frequency - 87.50 MHz) in 100 kHz steps for 0...204 or a RDSLOG_TAG_ value
+/// 3         | Errors of the blocks, 2 bits per block as in attachReceiveRDSExt(): A in bits 7:6 ... D in bits 1:0
+/// 4...11    | RDS blocks A, B, C and D (16 bit each)
+///
+/// Frequencies that have no tag are written as a RDSLOG_TAG_FREQ record with the frequency in block A
+/// and the band in block B. The following groups use RDSLOG_TAG_LAST.
+/// Unused records at the end of a sector use RDSLOG_TAG_NONE.
+/// Several logs can be appended to one file, each starts with a file header.
+///
+/// The recorder only fills sectors in RAM. Full sectors are taken by getSector() and written by the sketch
+/// at a convenient time, e.g. when no web request is active, while the next sector is filled.
+///
+/// More documentation and source code is available at http://www.mathertel.de/Arduino
+///
+/// History:
+/// --------
+/// * 18.10.2026 created.
+
+#ifndef __RDSLOG_H__
+#define __RDSLOG_H__
+
+#include <Arduino.h>
+#include <radio.h>
+
+#define RDSLOG_VERSION 1
+#define RDSLOG_SECTORSIZE 512
+#define RDSLOG_RECORDSIZE 12
+#define RDSLOG_SECTORHEADER 8
+#define RDSLOG_RECORDS ((RDSLOG_SECTORSIZE - RDSLOG_SECTORHEADER) / RDSLOG_RECORDSIZE)  ///< 42 records per sector.
+#define RDSLOG_SECTORMAGIC 0x4C52
+
+// frequency tags
+#define RDSLOG_TAG_MAX 204     ///< max. frequency tag: 107.90 MHz.
+#define RDSLOG_TAG_FREQ 0xF0   ///< control record: frequency in block A, band in block B.
+#define RDSLOG_TAG_LAST 0xFE   ///< group on the frequency of the last RDSLOG_TAG_FREQ record.
+#define RDSLOG_TAG_NONE 0xFF   ///< unused record.
+
+/// number of sector buffers in RAM.
+/// With 3 buffers the writing can be delayed while one full sector is pending and another one is filled.
+#if defined(ARDUINO_ARCH_AVR)
+#define RDSLOG_BUFFERS 3
+#else
+#define RDSLOG_BUFFERS 4
+#endif
+
+
+/// Recorder for RDS groups in the RDSLog format.
+class RDSLog {
+public:
+  RDSLog();  ///< create a new object from this class.
+
+  /// Start a new log. The file header is the first sector returned by getSector().
+  /// \param now The current time in msec.
+  /// \param source A name of the device or site, up to 16 chars.
+  void begin(unsigned long now, const char *source);
+
+  /// Set the frequency for the following groups.
+  void setFrequency(unsigned long now, RADIO_FREQ freq, RADIO_BAND band);
+
+  /// Add a RDS group. This function can be called from the callback registered by attachReceiveRDSExt().
+  /// \return false when all sector buffers are full and the group was dropped.
+  bool addGroup(unsigned long now, uint16_t block1, uint16_t block2, uint16_t block3, uint16_t block4, uint8_t errors);
+
+  /// Close the sector that is filled so it can be written, e.g. before stopping the log.
+  void flush();
+
+  /// Get the next full sector to be written.
+  /// \return a pointer to RDSLOG_SECTORSIZE bytes or NULL when no sector is full.
+  const uint8_t *getSector();
+
+  /// Release the sector from getSector() after it was written.
+  void releaseSector();
+
+  uint8_t getPending() { return (_full); };  ///< Number of full sectors waiting to be written.
+
+  uint32_t dropped;  ///< number of groups lost because all buffers were full.
+
+private:
+  uint8_t _buffer[RDSLOG_BUFFERS][RDSLOG_SECTORSIZE];
+  uint8_t _first;   ///< oldest full sector buffer.
+  uint8_t _full;    ///< number of full sector buffers.
+  bool _open;       ///< a sector is filled.
+  uint8_t _record;  ///< next record in the sector that is filled.
+
+  uint16_t _sequence;      ///< sequence number of the next sector.
+  unsigned long _last;     ///< time of the last record.
+  uint8_t _tag;            ///< frequency tag for the groups, RDSLOG_TAG_FREQ while the control record is not written.
+  RADIO_FREQ _freq;        ///< current frequency.
+  RADIO_BAND _band;        ///< current band.
+
+  uint8_t *_startRecord(unsigned long now);
+  void _closeSector();
+  bool _writeFrequency(unsigned long now);
+};  // RDSLog
+
+#endif  //__RDSLOG_H__
@@ -14,16 +14,21 @@
 /// ChangeLog see RDSParser.h.
 
 #include "RDSParser.h"
+#include "radio.h"
 
-#define DEBUG_FUNC0(fn) \
-  { \
-    Serial.print(fn); \
-    Serial.println("()"); \
-  }
+// A block can be used when the errors are corrected.
+#define BLOCK_OK(errors, n) (RDS_BLOCKERR(errors, n) != RDS_ERRLEVEL_UNCORRECT)
+
+// A block was received without any errors.
+#define BLOCK_CLEAN(errors, n) (RDS_BLOCKERR(errors, n) == RDS_ERRLEVEL_NONE)
+
+// number of changes of the error free service name to detect a dynamic PS.
+#define PS_DYNAMIC_CHANGES 2
 
 /// Setup the RDS object and initialize private variables to 0.
 RDSParser::RDSParser() {
   memset(this, 0, sizeof(RDSParser));
+  _fastPS = true;
 }  // RDSParser()
 
 
@@ -35,9 +40,109 @@ void RDSParser::init() {
   strcpy(lastServiceName, "        ");
   memset(_RDSText, 0, sizeof(_RDSText));
   _lastTextIDX = 0;
+
+  memset(_psFast, 0, sizeof(_psFast));
+  memset(_psLastFast, 0, sizeof(_psLastFast));
+  _psSegments = 0;
+  _psChanges = 0;
+  _psDynamic = false;
+
+  _initTime = millis();
+  _firstPSTime = 0;
+  _firstRTTime = 0;
+
+  // the cache is kept.
+  _pi = 0;
 }  // init()
 
 
+void RDSParser::setFastPS(bool enable) {
+  _fastPS = enable;
+}  // setFastPS()
+
+
+// send a new service name to the listener and measure the time to the first one.
+void RDSParser::_publishServiceName(const char *name) {
+  // a received name also counts when it confirms a cached name.
+  if (!_firstPSTime) _firstPSTime = max(millis() - _initTime, 1UL);
+
+  if (strcmp(lastServiceName, name) != 0) {
+    strcpy(lastServiceName, name);
+    if (_sendServiceName)
+      _sendServiceName(lastServiceName);
+  }
+
+  CacheEntry *e = _cacheFind(_pi, true);
+  if (e) {
+    memcpy(e->ps, name, 8);
+    e->pty = rdsPTY;
+  }
+}  // _publishServiceName()
+
+
+// Find the cache entry of a station and mark it as most recently used.
+// With create a new entry is created by replacing the least recently used one.
+RDSParser::CacheEntry *RDSParser::_cacheFind(uint16_t pi, bool create) {
+  CacheEntry *found = nullptr;
+  CacheEntry *oldest = &_cache[0];
+
+  if (pi == 0) return (nullptr);
+
+  for (uint8_t n = 0; n < RDS_CACHE_ENTRIES; n++) {
+    CacheEntry *e = &_cache[n];
+    if (e->pi == pi) {
+      found = e;
+      break;
+    } else if ((e->pi == 0) || ((oldest->pi != 0) && (e->age > oldest->age))) {
+      oldest = e;
+    }
+  }  // for
+
+  if ((!found) && (create)) {
+    found = oldest;
+    memset(found, 0, sizeof(CacheEntry));
+    found->pi = pi;
+    found->age = RDS_CACHE_ENTRIES;
+  }
+
+  if (found) {
+    // all entries that were used more recently get older.
+    for (uint8_t n = 0; n < RDS_CACHE_ENTRIES; n++) {
+      if ((_cache[n].pi) && (_cache[n].age < found->age)) _cache[n].age++;
+    }
+    found->age = 0;
+  }
+  return (found);
+}  // _cacheFind()
+
+
+// A new station is received, use the cached information until it is confirmed or replaced.
+void RDSParser::_changePI(uint16_t pi) {
+  if (_pi) {
+    // another station without a reset before.
+    // The times to PS and RT are still measured from the last tuning.
+    unsigned long tuneTime = _initTime;
+    init();
+    _initTime = tuneTime;
+    if (_sendText) _sendText("");
+  }
+  _pi = pi;
+
+  CacheEntry *e = _cacheFind(pi, false);
+  if (e) {
+    memcpy(programServiceName, e->ps, 8);
+    strcpy(lastServiceName, programServiceName);
+    rdsPTY = e->pty;
+    if (_sendServiceName) _sendServiceName(lastServiceName);
+
+#if RDS_CACHE_TEXTLEN > 0
+    memcpy(_RDSText, e->text, min(RDS_CACHE_TEXTLEN, 64));
+    if ((_RDSText[0]) && (_sendText)) _sendText(_RDSText);
+#endif
+  }  // if
+}  // _changePI()
+
+
 void RDSParser::attachServiceNameCallback(receiveServiceNameFunction newFunction) {
   _sendServiceName = newFunction;
 }  // attachServiceNameCallback
@@ -53,7 +158,14 @@ void RDSParser::attachTimeCallback(receiveTimeFunction newFunction) {
 
 
 void RDSParser::processData(uint16_t block1, uint16_t block2, uint16_t block3, uint16_t block4) {
+  processData(block1, block2, block3, block4, 0);
+}  // processData()
+
+
+void RDSParser::processData(uint16_t block1, uint16_t block2, uint16_t block3, uint16_t block4, uint8_t errors) {
   // DEBUG_FUNC0("process");
+  bool okC = BLOCK_OK(errors, 2);
+  bool okD = BLOCK_OK(errors, 3);
   uint8_t idx;  // index of rdsText
   char c1, c2;
 
@@ -62,7 +174,7 @@ void RDSParser::processData(uint16_t block1, uint16_t block2, uint16_t block3, u
 
   // Serial.print('('); Serial.print(block1, HEX); Serial.print(' '); Serial.print(block2, HEX); Serial.print(' '); Serial.print(block3, HEX); Serial.print(' '); Serial.println(block4, HEX);
 
-  if (block1 == 0) {
+  if ((block1 == 0) && (errors == 0)) {
     // reset all the RDS info.
     init();
     // Send out empty data
@@ -71,15 +183,24 @@ void RDSParser::processData(uint16_t block1, uint16_t block2, uint16_t block3, u
     return;
   }  // if
 
+  // the PI code from block 1 identifies the station.
+  if ((BLOCK_CLEAN(errors, 0)) && (block1 != _pi)) {
+    _changePI(block1);
+  }
+
+  // without block 2 the group type is unknown.
+  if (!BLOCK_OK(errors, 1)) return;
+
   // analyzing Block 2
   rdsGroupType = 0x0A | ((block2 & 0xF000) >> 8) | ((block2 & 0x0800) >> 11);
   rdsTP = (block2 & 0x0400);
-  rdsPTY = (block2 & 0x0400);
+  rdsPTY = (block2 >> 5) & 0x1F;
 
   switch (rdsGroupType) {
     case 0x0A:
     case 0x0B:
       // The data received is part of the Service Station Name
+      if (!okD) break;
       idx = 2 * (block2 & 0x0003); // idx = 0, 2, 4, 6
 
       // new data is 2 chars from block 4
@@ -97,6 +218,33 @@ void RDSParser::processData(uint16_t block1, uint16_t block2, uint16_t block3, u
       _PSName2[idx+1] = _PSName1[idx+1];
       _PSName1[idx+1] = c2;
 
+      if (BLOCK_CLEAN(errors, 1) && BLOCK_CLEAN(errors, 3)) {
+        // collect the error free segments of one cycle. A cycle starts with segment 0.
+        if (idx == 0) _psSegments = 0;
+        _psFast[idx] = c1;
+        _psFast[idx + 1] = c2;
+        _psSegments |= (1 << (idx / 2));
+
+        if ((idx == 6) && (_psSegments == 0x0F)) {
+          // a complete name without errors
+          if ((_psLastFast[0]) && (strcmp(_psLastFast, _psFast) != 0)) {
+            // static names are repeated, dynamic names change.
+            if (_psChanges < PS_DYNAMIC_CHANGES) _psChanges++;
+            _psDynamic = (_psChanges >= PS_DYNAMIC_CHANGES);
+          }
+          strcpy(_psLastFast, _psFast);
+          if (_fastPS) {
+            // no voting required.
+            strcpy(programServiceName, _psFast);
+            _publishServiceName(programServiceName);
+            _psSegments = 0;
+            break;
+          }
+        }
+      } else {
+        _psSegments = 0;
+      }  // if
+
       // check that the data was received successfully twice
       // before publishing the station name
       if (idx == 6) {
@@ -113,10 +261,8 @@ void RDSParser::processData(uint16_t block1, uint16_t block2, uint16_t block3, u
             isGood = false;
           }
         }
-        if ((isGood) && (strcmp(lastServiceName, programServiceName) != 0)) {
-          strcpy(lastServiceName, programServiceName);
-          if (_sendServiceName)
-            _sendServiceName(programServiceName);
+        if (isGood) {
+          _publishServiceName(programServiceName);
         }
       } // if
       break;
@@ -129,6 +275,11 @@ void RDSParser::processData(uint16_t block1, uint16_t block2, uint16_t block3, u
       if (idx < _lastTextIDX) {
         // the existing text might be complete because the index is starting at the beginning again.
         // now send it to the possible listener.
+        if ((!_firstRTTime) && (_RDSText[0])) _firstRTTime = max(millis() - _initTime, 1UL);
+#if RDS_CACHE_TEXTLEN > 0
+        CacheEntry *e = _cacheFind(_pi, false);
+        if (e) memcpy(e->text, _RDSText, min(RDS_CACHE_TEXTLEN, 64));
+#endif
         if (_sendText)
           _sendText(_RDSText);
       }
@@ -143,16 +294,18 @@ void RDSParser::processData(uint16_t block1, uint16_t block2, uint16_t block3, u
 
 
       // new data is 2 chars from block 3
-      _RDSText[idx] = (block3 >> 8);
-      idx++;
-      _RDSText[idx] = (block3 & 0x00FF);
-      idx++;
+      if (okC) {
+        _RDSText[idx] = (block3 >> 8);
+        _RDSText[idx + 1] = (block3 & 0x00FF);
+      }
+      idx += 2;
 
       // new data is 2 chars from block 4
-      _RDSText[idx] = (block4 >> 8);
-      idx++;
-      _RDSText[idx] = (block4 & 0x00FF);
-      idx++;
+      if (okD) {
+        _RDSText[idx] = (block4 >> 8);
+        _RDSText[idx + 1] = (block4 & 0x00FF);
+      }
+      idx += 2;
 
       // Serial.print(' '); Serial.println(_RDSText);
       // Serial.print("T>"); Serial.println(_RDSText);
@@ -160,6 +313,7 @@ void RDSParser::processData(uint16_t block1, uint16_t block2, uint16_t block3, u
 
     case 0x4A:
       // Clock time and date
+      if ((!okC) || (!okD)) break;
       off = (block4)&0x3F;          // 6 bits
       mins = (block4 >> 6) & 0x3F;  // 6 bits
       mins += 60 * (((block3 & 0x0001) << 4) | ((block4 >> 12) & 0x0F));
@@ -16,6 +16,9 @@
 /// * 01.09.2014 created and RDS sender name working.
 /// * 01.11.2014 RDS time added.
 /// * 27.03.2015 Reset RDS data by sending a 0 in blockA in the case the frequency changes.
+/// * 18.10.2026 Using partially correct groups by passing the block error levels.
+/// * 18.10.2026 Fast PS acquisition, dynamic PS detection and time to first PS / RT.
+/// * 18.10.2026 Cache of recently received stations by PI code, PTY fixed.
 ///
 
 
@@ -24,6 +27,24 @@
 
 #include <Arduino.h>
 
+// Number of stations in the cache of service names and texts (1..32).
+#ifndef RDS_CACHE_ENTRIES
+#if defined(ARDUINO_ARCH_AVR)
+#define RDS_CACHE_ENTRIES 4
+#else
+#define RDS_CACHE_ENTRIES 16
+#endif
+#endif
+
+// Length of the RDS text that is cached per station, 0 to cache only the service name.
+#ifndef RDS_CACHE_TEXTLEN
+#if defined(ARDUINO_ARCH_AVR)
+#define RDS_CACHE_TEXTLEN 0
+#else
+#define RDS_CACHE_TEXTLEN 64
+#endif
+#endif
+
 /// callback function for passing a ServiceName, text and Time when RDS is available.
 extern "C" {
   typedef void (*receiveServiceNameFunction)(const char *name);
@@ -43,10 +64,36 @@ public:
   /// Pass all available RDS data through this function.
   void processData(uint16_t block1, uint16_t block2, uint16_t block3, uint16_t block4);
 
+  /// Pass all available RDS data including the error levels of the blocks through this function.
+  /// The errors are packed by 2 bits per block: A in bits 7:6 ... D in bits 1:0.
+  /// Only the blocks that are needed for the specific group type must be correct.
+  void processData(uint16_t block1, uint16_t block2, uint16_t block3, uint16_t block4, uint8_t errors);
+
   void attachServiceNameCallback(receiveServiceNameFunction newFunction);  ///< Register function for displaying a new Service Name.
   void attachTextCallback(receiveTextFunction newFunction);                ///< Register the function for displaying a rds text.
   void attachTimeCallback(receiveTimeFunction newFunction);                ///< Register function for displaying a new time
 
+  /// Publish the service name as soon as all 4 segments are received without errors in one cycle (default).
+  /// When switched off or under errors the name is published after a 2 of 3 agreement.
+  void setFastPS(bool enable = true);
+
+  /// Return true when the station is sending a changing service name (dynamic PS).
+  bool isDynamicPS() { return (_psDynamic); };
+
+  /// Return the time in msec from init() to the first service name or 0 when not available yet.
+  /// A change of the PI code without init() keeps the start time.
+  unsigned long getTimeToPS() { return (_firstPSTime); };
+
+  /// Return the time in msec from init() to the first complete RDS text or 0 when not available yet.
+  /// A change of the PI code without init() keeps the start time.
+  unsigned long getTimeToRT() { return (_firstRTTime); };
+
+  /// Return the program identification code of the current station or 0 when not known yet.
+  uint16_t getPI() { return (_pi); };
+
+  /// Return the program type of the current station.
+  uint8_t getPTY() { return (rdsPTY); };
+
 private:
   // ----- actual RDS values
   uint8_t rdsGroupType, rdsTP, rdsPTY;
@@ -61,6 +108,39 @@ private:
   char programServiceName[10];  // found station name or empty. Is max. 8 character long.
   char lastServiceName[10];     // found station name or empty. Is max. 8 character long.
 
+  // fast acquisition of the Program Service Name
+  bool _fastPS;          ///< publish error free names immediately.
+  char _psFast[10];      ///< segments received without errors in the current cycle.
+  char _psLastFast[10];  ///< last name received completely without errors.
+  uint8_t _psSegments;   ///< bit mask of the segments received without errors in the current cycle.
+  uint8_t _psChanges;    ///< number of changes of error free names.
+  bool _psDynamic;       ///< the station sends a dynamic PS.
+
+  unsigned long _initTime;     ///< time of init() in millis.
+  unsigned long _firstPSTime;  ///< time from init() to the first service name.
+  unsigned long _firstRTTime;  ///< time from init() to the first RDS text.
+
+  void _publishServiceName(const char *name);
+
+  // ----- Cache of recently received stations
+
+  /// A cached station, the strings are stored without trailing '\00'.
+  struct CacheEntry {
+    uint16_t pi;   ///< program identification, 0 = unused entry.
+    uint8_t age;   ///< 0 = most recently used.
+    uint8_t pty;   ///< program type.
+    char ps[8];    ///< service name.
+#if RDS_CACHE_TEXTLEN > 0
+    char text[RDS_CACHE_TEXTLEN];  ///< last RDS text.
+#endif
+  } __attribute__((packed));
+
+  CacheEntry _cache[RDS_CACHE_ENTRIES];
+  uint16_t _pi;  ///< PI code of the current station.
+
+  CacheEntry *_cacheFind(uint16_t pi, bool create);
+  void _changePI(uint16_t pi);
+
   receiveServiceNameFunction _sendServiceName;  ///< Registered ServiceName function.
   receiveTimeFunction _sendTime;                ///< Registered Time function.
   receiveTextFunction _sendText;
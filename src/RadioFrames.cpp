@@ -0,0 +1,242 @@
+///
+/// \file RadioFrames.cpp
+/// \brief Binary framed command protocol for controlling a radio over a serial line.
+///
+/// \author Matthias Hertel, http://www.mathertel.de
+/// \copyright Copyright (c) by Matthias Hertel.\n
+/// This work is licensed under a BSD 3-Clause license.\n
+/// See http://www.mathertel.de/License.aspx
+///
+/// \details
+/// See RadioFrames.h for the frame layout.
+///
+/// More documentation and source code is available at http://www.mathertel.de/Arduino
+///
+/// History:
+/// --------
+/// * 18.10.2026 created.
+/// * 18.10.2026 timeout for partial frames.
+/// * 18.10.2026 RDS group frames include the error levels of the blocks.
+
+#include "RadioFrames.h"
+
+#define HIBYTE(v) ((uint8_t)((v) >> 8))
+#define LOBYTE(v) ((uint8_t)((v)&0xFF))
+
+
+RadioFrames::RadioFrames() {
+  _port = NULL;
+  _radio = NULL;
+  _sendRDS = false;
+  _statusInterval = 0;
+  _lastStatus = 0;
+  _rxLen = 0;
+  _rxTime = 0;
+  crcErrors = 0;
+}  // RadioFrames()
+
+
+void RadioFrames::begin(Stream &port, RADIO &radio) {
+  _port = &port;
+  _radio = &radio;
+  _rxLen = 0;
+}  // begin()
+
+
+uint16_t RadioFrames::crc16(uint16_t crc, uint8_t data) {
+  crc ^= (uint16_t)data << 8;
+  for (uint8_t n = 0; n < 8; n++) {
+    if (crc & 0x8000) {
+      crc = (crc << 1) ^ 0x1021;
+    } else {
+      crc = (crc << 1);
+    }
+  }
+  return (crc);
+}  // crc16()
+
+
+void RadioFrames::sendFrame(uint8_t cmd, const uint8_t *data, uint8_t len) {
+  uint8_t frame[3 + RADIOFRAME_MAXDATA + 2];
+  uint16_t crc = 0xFFFF;
+
+  if ((!_port) || (len > RADIOFRAME_MAXDATA)) return;
+
+  frame[0] = RADIOFRAME_SYNC;
+  frame[1] = len;
+  frame[2] = cmd;
+  memcpy(frame + 3, data, len);
+
+  for (uint8_t n = 1; n < 3 + len; n++) {
+    crc = crc16(crc, frame[n]);
+  }
+  frame[3 + len] = HIBYTE(crc);
+  frame[4 + len] = LOBYTE(crc);
+
+  // one write call for the complete frame.
+  _port->write(frame, 5 + len);
+}  // sendFrame()
+
+
+void RadioFrames::sendStatus() {
+  RADIO_INFO ri;
+  AUDIO_INFO ai;
+  uint8_t data[11];
+
+  RADIO_FREQ f = _radio->getFrequency();
+  _radio->getRadioInfo(&ri);
+  _radio->getAudioInfo(&ai);
+  unsigned long now = millis();
+
+  uint8_t flags = 0;
+  if (ri.tuned) flags |= RADIOFRAME_FLAG_TUNED;
+  if (ri.stereo) flags |= RADIOFRAME_FLAG_STEREO;
+  if (ri.rds) flags |= RADIOFRAME_FLAG_RDS;
+  if (ri.mono) flags |= RADIOFRAME_FLAG_MONO;
+  if (ai.mute) flags |= RADIOFRAME_FLAG_MUTE;
+  if (ai.softmute) flags |= RADIOFRAME_FLAG_SOFTMUTE;
+  if (ai.bassBoost) flags |= RADIOFRAME_FLAG_BASSBOOST;
+
+  data[0] = HIBYTE(f);
+  data[1] = LOBYTE(f);
+  data[2] = _radio->getBand();
+  data[3] = flags;
+  data[4] = ri.rssi;
+  data[5] = ri.snr;
+  data[6] = ai.volume;
+  data[7] = (uint8_t)(now >> 24);
+  data[8] = (uint8_t)(now >> 16);
+  data[9] = (uint8_t)(now >> 8);
+  data[10] = (uint8_t)(now);
+  sendFrame(RADIOFRAME_STATUS, data, sizeof(data));
+}  // sendStatus()
+
+
+void RadioFrames::sendRDS(uint16_t block1, uint16_t block2, uint16_t block3, uint16_t block4, uint8_t errors) {
+  if (_sendRDS) {
+    uint8_t data[9] = {
+      HIBYTE(block1), LOBYTE(block1), HIBYTE(block2), LOBYTE(block2),
+      HIBYTE(block3), LOBYTE(block3), HIBYTE(block4), LOBYTE(block4),
+      errors
+    };
+    sendFrame(RADIOFRAME_RDS, data, sizeof(data));
+  }
+}  // sendRDS()
+
+
+void RadioFrames::setStatusInterval(uint16_t interval) {
+  _statusInterval = interval;
+  _lastStatus = millis();
+}  // setStatusInterval()
+
+
+bool RadioFrames::loop() {
+  bool ret = true;
+
+  if ((!_port) || (!_radio)) return (false);
+
+  if ((_rxLen > 0) && (millis() - _rxTime > RADIOFRAME_RXTIMEOUT)) {
+    // the rest of the frame was lost, search for the next sync byte.
+    _rxLen = 0;
+  }
+
+  while (_port->available() > 0) {
+    uint8_t c = _port->read();
+
+    if ((_rxLen == 0) && (c != RADIOFRAME_SYNC)) {
+      // skip data until sync byte.
+      continue;
+
+    } else if ((_rxLen == 1) && (c > RADIOFRAME_MAXDATA)) {
+      // not a valid length, search for the next sync byte.
+      _rxLen = 0;
+      continue;
+    }
+
+    _rx[_rxLen++] = c;
+    _rxTime = millis();
+
+    if ((_rxLen > 2) && (_rxLen == 5 + _rx[1])) {
+      // frame complete
+      uint8_t len = _rx[1];
+      uint16_t crc = 0xFFFF;
+      for (uint8_t n = 1; n < 3 + len; n++) {
+        crc = crc16(crc, _rx[n]);
+      }
+      _rxLen = 0;
+
+      if ((_rx[3 + len] != HIBYTE(crc)) || (_rx[4 + len] != LOBYTE(crc))) {
+        crcErrors++;
+        uint8_t id = 0;
+        sendFrame(RADIOFRAME_NAK, &id, 1);
+
+      } else if (_rx[2] == RADIOFRAME_EXIT) {
+        sendFrame(RADIOFRAME_ACK, &_rx[2], 1);
+        _sendRDS = false;
+        _statusInterval = 0;
+        ret = false;
+        break;
+
+      } else if (!_execute(_rx[2], _rx + 3, len)) {
+        sendFrame(RADIOFRAME_NAK, &_rx[2], 1);
+      }
+    }  // if
+  }    // while
+
+  if ((ret) && (_statusInterval) && (millis() - _lastStatus >= _statusInterval)) {
+    sendStatus();
+    _lastStatus = millis();
+  }
+  return (ret);
+}  // loop()
+
+
+/// Execute a command and send the response.
+/// \return false when the command is unknown or has a wrong payload.
+bool RadioFrames::_execute(uint8_t cmd, uint8_t *data, uint8_t len) {
+  uint16_t value = 0;
+  bool ret = true;
+
+  // most commands have one parameter with 8 or 16 bit.
+  if (len == 1) {
+    value = data[0];
+  } else if (len >= 2) {
+    value = (data[0] << 8) | data[1];
+  }
+
+  if ((cmd == RADIOFRAME_SETFREQ) && (len == 2)) {
+    _radio->setFrequency(value);
+  } else if ((cmd == RADIOFRAME_SETVOLUME) && (len == 1)) {
+    _radio->setVolume(value);
+  } else if ((cmd == RADIOFRAME_SETMUTE) && (len == 1)) {
+    _radio->setMute(value);
+  } else if ((cmd == RADIOFRAME_SETSOFTMUTE) && (len == 1)) {
+    _radio->setSoftMute(value);
+  } else if ((cmd == RADIOFRAME_SETMONO) && (len == 1)) {
+    _radio->setMono(value);
+  } else if ((cmd == RADIOFRAME_SETBASSBOOST) && (len == 1)) {
+    _radio->setBassBoost(value);
+  } else if ((cmd == RADIOFRAME_SEEK) && (len == 1)) {
+    if (value) {
+      _radio->seekUp(true);
+    } else {
+      _radio->seekDown(true);
+    }
+  } else if ((cmd == RADIOFRAME_SETBAND) && (len == 3)) {
+    _radio->setBandFrequency((RADIO_BAND)data[0], (data[1] << 8) | data[2]);
+  } else if ((cmd == RADIOFRAME_SETINTERVAL) && (len == 2)) {
+    setStatusInterval(value);
+  } else if ((cmd == RADIOFRAME_SETRDS) && (len == 1)) {
+    _sendRDS = value;
+  } else if ((cmd == RADIOFRAME_GETSTATUS) && (len == 0)) {
+    sendStatus();
+    return (true);
+  } else {
+    ret = false;
+  }
+
+  if (ret) sendFrame(RADIOFRAME_ACK, &cmd, 1);
+  return (ret);
+}  // _execute()
+
+// End.
@@ -0,0 +1,128 @@
+///
+/// \file RadioFrames.h
+/// \brief Binary framed command protocol for controlling a radio over a serial line.
+///
+/// \author Matthias Hertel, http://www.mathertel.de
+/// \copyright Copyright (c) by Matthias Hertel.\n
+/// This work is licensed under a BSD 3-Clause license.\n
+/// See http://www.mathertel.de/License.aspx
+///
+/// \details
+/// The protocol is an optional alternative to the ASCII commands of the SerialRadio and ScanRadio examples
+/// for host tools that need status and RDS data at full rate without text formatting on the MCU.
+///
+/// Every frame in both directions has the same layout:
+///
+/// Byte      | Content
+/// :-------- | :------------------------------------------------------
+/// 0         | Sync byte 0xA5
+/// 1         | Length of the payload (0...RADIOFRAME_MAXDATA)
+/// 2         | Command or response ID
+/// 3...      | Payload, 16 bit values in High-Low order
+/// last 2    | CRC-16/CCITT (poly 0x1021, init 0xFFFF) over length, ID and payload, High-Low order
+///
+/// Frames with a wrong CRC are dropped and answered by a NAK frame.
+/// A partial frame is dropped when the next byte does not arrive within RADIOFRAME_RXTIMEOUT msec.
+/// Every valid command is answered by an ACK frame containing the command ID
+/// or by the requested response frame.
+///
+/// More documentation and source code is available at http://www.mathertel.de/Arduino
+///
+/// History:
+/// --------
+/// * 18.10.2026 created.
+/// * 18.10.2026 timeout for partial frames.
+/// * 18.10.2026 RDS group frames include the error levels of the blocks.
+
+#ifndef __RADIOFRAMES_H__
+#define __RADIOFRAMES_H__
+
+#include <Arduino.h>
+#include <radio.h>
+
+#define RADIOFRAME_SYNC 0xA5
+#define RADIOFRAME_MAXDATA 32
+#define RADIOFRAME_RXTIMEOUT 50  ///< max. msec. between 2 bytes of a frame.
+
+// ----- commands from the host -----
+
+#define RADIOFRAME_SETFREQ 0x01      ///< payload: frequency (16 bit)
+#define RADIOFRAME_SETVOLUME 0x02    ///< payload: volume (8 bit)
+#define RADIOFRAME_SETMUTE 0x03      ///< payload: 0 | 1
+#define RADIOFRAME_SETSOFTMUTE 0x04  ///< payload: 0 | 1
+#define RADIOFRAME_SETMONO 0x05      ///< payload: 0 | 1
+#define RADIOFRAME_SETBASSBOOST 0x06 ///< payload: 0 | 1
+#define RADIOFRAME_SEEK 0x07         ///< payload: 1 = up, 0 = down
+#define RADIOFRAME_SETBAND 0x08      ///< payload: RADIO_BAND (8 bit), frequency (16 bit)
+
+#define RADIOFRAME_GETSTATUS 0x10    ///< no payload, answered by a status frame.
+#define RADIOFRAME_SETINTERVAL 0x11  ///< payload: status frame interval in msec. (16 bit), 0 = off.
+#define RADIOFRAME_SETRDS 0x12       ///< payload: 1 = stream RDS group frames, 0 = off.
+#define RADIOFRAME_EXIT 0x1F         ///< no payload, leave the binary mode.
+
+// ----- responses to the host -----
+
+#define RADIOFRAME_ACK 0x80     ///< payload: command ID
+#define RADIOFRAME_NAK 0x81     ///< payload: command ID or 0 on CRC errors.
+#define RADIOFRAME_STATUS 0x82  ///< payload: see sendStatus()
+#define RADIOFRAME_RDS 0x83     ///< payload: 4 RDS blocks (16 bit), error levels (8 bit) packed like RDS_PACKERRORS()
+
+// flags in the status frame
+#define RADIOFRAME_FLAG_TUNED 0x01
+#define RADIOFRAME_FLAG_STEREO 0x02
+#define RADIOFRAME_FLAG_RDS 0x04
+#define RADIOFRAME_FLAG_MONO 0x08
+#define RADIOFRAME_FLAG_MUTE 0x10
+#define RADIOFRAME_FLAG_SOFTMUTE 0x20
+#define RADIOFRAME_FLAG_BASSBOOST 0x40
+
+
+/// Implementation of the binary framed protocol on a Stream like Serial.
+class RadioFrames {
+public:
+  RadioFrames();  ///< create a new object from this class.
+
+  /// Start using the protocol on the given port for the given radio.
+  void begin(Stream &port, RADIO &radio);
+
+  /// Check for incoming frames and execute the commands.
+  /// Status frames are sent when the interval is over.
+  /// \return false when the host has sent the EXIT command.
+  bool loop();
+
+  /// Send a packed status frame with frequency, band, flags, rssi, snr, volume and the time.
+  void sendStatus();
+
+  /// Send a RDS group frame when the RDS stream is enabled.
+  /// All groups should be passed with their error levels so host tools get the raw data.
+  /// This is a member function and cannot be registered by attachReceiveRDS() directly.
+  /// Call it from the RDS callback function of the sketch, see SerialRadio.
+  void sendRDS(uint16_t block1, uint16_t block2, uint16_t block3, uint16_t block4, uint8_t errors = 0);
+
+  /// Send a frame with the given command and payload.
+  void sendFrame(uint8_t cmd, const uint8_t *data, uint8_t len);
+
+  /// Set the interval in msec. for sending status frames. 0 disables the status frames.
+  void setStatusInterval(uint16_t interval);
+
+  /// Calculate the CRC-16/CCITT checksum by adding a byte.
+  static uint16_t crc16(uint16_t crc, uint8_t data);
+
+  uint16_t crcErrors;  ///< number of frames with a wrong CRC.
+
+private:
+  Stream *_port;
+  RADIO *_radio;
+
+  bool _sendRDS;             ///< stream RDS group frames.
+  uint16_t _statusInterval;  ///< interval for status frames.
+  unsigned long _lastStatus; ///< time of the last status frame.
+
+  uint8_t _rxLen;  ///< number of received bytes of the actual frame.
+  unsigned long _rxTime;  ///< time of the last received byte of the actual frame.
+  uint8_t _rx[3 + RADIOFRAME_MAXDATA + 2];
+
+  bool _execute(uint8_t cmd, uint8_t *data, uint8_t len);
+};  // RadioFrames
+
+#endif  //__RADIOFRAMES_H__
@@ -0,0 +1,97 @@
+///
+/// \file RadioInput.cpp
+/// \brief Input events from interrupts for the user interface of a radio.
+///
+/// \author Matthias Hertel, http://www.mathertel.de
+/// \copyright Copyright (c) by Matthias Hertel.\n
+/// This work is licensed under a BSD 3-Clause license.\n
+/// See http://www.mathertel.de/License.aspx
+///
+/// \details
+/// See RadioInput.h for the usage.
+///
+/// More documentation and source code is available at http://www.mathertel.de/Arduino
+///
+/// History:
+/// --------
+/// * 18.10.2026 created.
+
+#include "RadioInput.h"
+
+// The compiler must not move writes to the queue entry behind the update of the index.
+#define RADIOINPUT_BARRIER() __asm__ __volatile__("" ::: "memory")
+
+// functions called from interrupts must be placed in RAM on ESP8266 and ESP32.
+#if !defined(IRAM_ATTR)
+#define IRAM_ATTR
+#endif
+
+
+RadioInput::RadioInput() {
+  _head = 0;
+  _tail = 0;
+  _dropped = 0;
+  _position = 0;
+  _key = 0;
+  _keyRaw = 0;
+  _keyCount = 0;
+}  // RadioInput()
+
+
+IRAM_ATTR bool RadioInput::push(uint8_t type, int8_t value) {
+  uint8_t next = (_head + 1) & (RADIOINPUT_QUEUESIZE - 1);
+
+  if (next == _tail) {
+    if (_dropped < 0xFF) _dropped++;
+    return (false);
+  }
+
+  RADIOINPUT_EVENT *e = &_queue[_head];
+  e->type = type;
+  e->value = value;
+  e->time = (uint16_t)millis();
+  RADIOINPUT_BARRIER();
+  _head = next;
+  return (true);
+}  // push()
+
+
+bool RadioInput::pop(RADIOINPUT_EVENT *event) {
+  uint8_t tail = _tail;
+
+  if (tail == _head) return (false);
+  RADIOINPUT_BARRIER();
+  *event = _queue[tail];
+  RADIOINPUT_BARRIER();
+  _tail = (tail + 1) & (RADIOINPUT_QUEUESIZE - 1);
+  return (true);
+}  // pop()
+
+
+IRAM_ATTR void RadioInput::encoderTick(long position) {
+  long steps = position - _position;
+
+  // when the queue is full the steps are kept and sent with the next event.
+  if ((steps) && (((_head + 1) & (RADIOINPUT_QUEUESIZE - 1)) != _tail)) {
+    steps = constrain(steps, -127, 127);
+    push(RADIOINPUT_ENCODER, steps);
+    _position += steps;
+  }
+}  // encoderTick()
+
+
+IRAM_ATTR void RadioInput::keyTick(uint8_t key) {
+  if (key != _keyRaw) {
+    // the key is changing or bouncing
+    _keyRaw = key;
+    _keyCount = 0;
+
+  } else if (_keyCount < RADIOINPUT_DEBOUNCE) {
+    if ((++_keyCount == RADIOINPUT_DEBOUNCE) && (key != _key)) {
+      // the key is stable now
+      if (_key) push(RADIOINPUT_KEYUP, _key);
+      if (key) push(RADIOINPUT_KEYDOWN, key);
+      _key = key;
+    }
+  }  // if
+}  // keyTick()
@@ -0,0 +1,82 @@
+///
+/// \file RadioInput.h
+/// \brief Input events from interrupts for the user interface of a radio.
+///
+/// \author Matthias Hertel, http://www.mathertel.de
+/// \copyright Copyright (c) by Matthias Hertel.\n
+/// This work is licensed under a BSD 3-Clause license.\n
+/// See http://www.mathertel.de/License.aspx
+///
+/// \details
+/// The inputs of a rotary encoder and keys are captured in interrupt routines
+/// and passed as events through a queue to the user interface in loop().
+/// No input is lost while loop() is blocked by a long radio function like tuning or seeking.
+///
+/// The queue is lock-free for one producer and one consumer:
+/// encoderTick() and keyTick() are called from interrupts that do not interrupt each other,
+/// pop() is called from loop().
+/// Every event carries the time of the capture so clicks and double clicks can be detected later.
+///
+/// More documentation and source code is available at http://www.mathertel.de/Arduino
+///
+/// History:
+/// --------
+/// * 18.10.2026 created.
+
+#ifndef __RADIOINPUT_H__
+#define __RADIOINPUT_H__
+
+#include <Arduino.h>
+
+#define RADIOINPUT_QUEUESIZE 16  ///< number of events in the queue, must be a power of 2.
+#define RADIOINPUT_DEBOUNCE 3    ///< number of samples a key must stay unchanged to be stable.
+
+// event types
+#define RADIOINPUT_ENCODER 0x01  ///< value: steps of the rotary encoder since the last event.
+#define RADIOINPUT_KEYDOWN 0x02  ///< value: the key that was pressed.
+#define RADIOINPUT_KEYUP 0x03    ///< value: the key that was released.
+
+/// An input event in the queue.
+struct RADIOINPUT_EVENT {
+  uint8_t type;   ///< event type.
+  int8_t value;   ///< steps or key.
+  uint16_t time;  ///< time of the capture, lower 16 bits of millis().
+};
+
+
+/// Queue of input events from interrupt routines.
+class RadioInput {
+public:
+  RadioInput();  ///< create a new object from this class.
+
+  /// Add an event to the queue, to be called from an interrupt routine.
+  /// \return false when the queue is full and the event was dropped.
+  bool push(uint8_t type, int8_t value);
+
+  /// Get the next event from the queue, to be called from loop().
+  /// \return false when there is no event.
+  bool pop(RADIOINPUT_EVENT *event);
+
+  /// Add an encoder event with the steps since the last call, to be called from an interrupt routine.
+  /// \param position The current position of the rotary encoder.
+  void encoderTick(long position);
+
+  /// Debounce the key sampled in a timer interrupt and add events for changes.
+  /// \param key The pressed key or 0 for no key.
+  void keyTick(uint8_t key);
+
+  uint8_t getDropped() { return (_dropped); };  ///< Number of events lost because the queue was full.
+
+private:
+  RADIOINPUT_EVENT _queue[RADIOINPUT_QUEUESIZE];
+  volatile uint8_t _head;  ///< next free entry, only changed by the producer.
+  volatile uint8_t _tail;  ///< next event to be read, only changed by the consumer.
+  volatile uint8_t _dropped;
+
+  long _position;    ///< encoder position of the last event.
+  uint8_t _key;      ///< last reported key.
+  uint8_t _keyRaw;   ///< last sampled key.
+  uint8_t _keyCount; ///< number of equal samples.
+};  // RadioInput
+
+#endif  //__RADIOINPUT_H__
@@ -0,0 +1,151 @@
+///
+/// \file RadioProfiler.cpp
+/// \brief Timing of named sections in the main loop of a radio application.
+///
+/// \author Matthias Hertel, http://www.mathertel.de
+/// \copyright Copyright (c) by Matthias Hertel.\n
+/// This work is licensed under a BSD 3-Clause license.\n
+/// See http://www.mathertel.de/License.aspx
+///
+/// \details
+/// See RadioProfiler.h for the usage.
+///
+/// More documentation and source code is available at http://www.mathertel.de/Arduino
+///
+/// History:
+/// --------
+/// * 18.10.2026 created.
+
+#include "RadioProfiler.h"
+
+
+RadioProfiler::RadioProfiler(RADIOPROFILER_SECTION *sections, const char *const *names, uint8_t count) {
+  _sections = sections;
+  _names = names;
+  _count = count;
+  _budget = UINT32_MAX;
+  reset();
+}  // RadioProfiler()
+
+
+void RadioProfiler::reset() {
+  memset(_sections, 0, _count * sizeof(RADIOPROFILER_SECTION));
+  for (uint8_t n = 0; n < _count; n++) _sections[n].low = UINT32_MAX;
+  _worst = 0;
+  _worstTicks = 0;
+  _worstTime = 0;
+  _resetPending = false;
+}  // reset()
+
+
+void RadioProfiler::setBudget(uint32_t usec) {
+#if defined(ESP8266) || defined(ESP32)
+  _budget = usec * ESP.getCpuFreqMHz();
+#else
+  _budget = usec;
+#endif
+}  // setBudget()
+
+
+uint32_t RadioProfiler::_toMicros(uint32_t ticks) {
+#if defined(ESP8266) || defined(ESP32)
+  return (ticks / ESP.getCpuFreqMHz());
+#else
+  return (ticks);
+#endif
+}  // _toMicros()
+
+
+uint32_t RadioProfiler::getMin(uint8_t section) {
+  return (_sections[section].count ? _toMicros(_sections[section].low) : 0);
+}  // getMin()
+
+
+uint32_t RadioProfiler::getAvg(uint8_t section) {
+  RADIOPROFILER_SECTION *s = &_sections[section];
+  return (s->count ? _toMicros((uint32_t)(s->sum / s->count)) : 0);
+}  // getAvg()
+
+
+uint32_t RadioProfiler::getMax(uint8_t section) {
+  return (_toMicros(_sections[section].high));
+}  // getMax()
+
+
+// The upper bound of the bucket that contains the percentile, but not more than the max.
+uint32_t RadioProfiler::getPercentile(uint8_t section, uint8_t percent) {
+  RADIOPROFILER_SECTION *s = &_sections[section];
+  uint32_t total = s->samples, sum = 0;
+
+  if (total == 0) return (0);
+
+  uint32_t limit = (total * percent + 99) / 100;
+  for (uint8_t b = 0; b < RADIOPROFILER_BUCKETS - 1; b++) {
+    sum += s->hist[b];
+    if (sum >= limit) {
+      // bucket b contains the ticks from (2 + (b & 1)) << ((b >> 1) - 1) on.
+      uint8_t next = b + 1;
+      uint32_t upper = (b < 2) ? 1 : ((uint32_t)(2 + (next & 1)) << ((next >> 1) - 1)) - 1;
+      return (_toMicros(min(upper, s->high)));
+    }
+  }
+  return (_toMicros(s->high));
+}  // getPercentile()
+
+
+bool RadioProfiler::getLine(uint8_t line, char *s) {
+  if (line == 0) {
+    snprintf(s, RADIOPROFILER_LINE, "%-10s %8s %6s %6s %7s %7s %5s", "section", "count", "min", "avg", "p99", "max", "over");
+
+  } else if (line <= _count) {
+    uint8_t n = line - 1;
+    snprintf(s, RADIOPROFILER_LINE, "%-10s %8lu %6lu %6lu %7lu %7lu %5u", _names[n], (unsigned long)getCount(n),
+             (unsigned long)getMin(n), (unsigned long)getAvg(n), (unsigned long)getPercentile(n, 99),
+             (unsigned long)getMax(n), _sections[n].over);
+
+  } else if ((line == _count + 1) && (_worstTicks > 0)) {
+    snprintf(s, RADIOPROFILER_LINE, "worst: %s %lu usec at %lu msec", _names[_worst],
+             (unsigned long)_toMicros(_worstTicks), (unsigned long)_worstTime);
+
+  } else {
+    return (false);
+  }
+  return (true);
+}  // getLine()
+
+
+void RadioProfiler::print(Print &out) {
+  char s[RADIOPROFILER_LINE];
+  for (uint8_t line = 0; getLine(line, s); line++) out.println(s);
+}  // print()
+
+
+// 1000 measurements take as many µsec as one takes nsec.
+uint32_t RadioProfiler::getCost() {
+  static const char *const names[] = { "cost" };
+  static RADIOPROFILER_SECTION section;
+  RadioProfiler profiler(&section, names, 1);
+  uint32_t start = micros();
+
+  for (uint16_t n = 0; n < 1000; n++) {
+    RADIOPROFILE(profiler, 0);
+  }
+  return (micros() - start);
+}  // getCost()
+
+
+void RadioProfiler::_setWorst(uint8_t section, uint32_t ticks) {
+  _worst = section;
+  _worstTicks = ticks;
+  _worstTime = millis();
+}  // _setWorst()
+
+
+// halve all buckets, rounded up so a bucket with samples is never emptied.
+void RadioProfiler::_halve(RADIOPROFILER_SECTION *s) {
+  s->samples = 0;
+  for (uint8_t b = 0; b < RADIOPROFILER_BUCKETS; b++) {
+    s->hist[b] = (s->hist[b] + 1) >> 1;
+    s->samples += s->hist[b];
+  }
+}  // _halve()
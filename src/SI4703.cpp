@@ -131,8 +131,8 @@ bool SI4703::init() {
 
   RADIO::init();  // will create reset impulse
 
-  _i2cPort->begin();  // Now that the unit is reset and I2C inteface mode, we need to begin I2C
-  found = RADIO::_wireExists(_i2cPort, _i2caddr);
+  _bus->begin();  // Now that the unit is reset and I2C inteface mode, we need to begin I2C
+  found = RADIO::_wireExists(_bus, _i2caddr);
 
   _readRegisters();  // Read the current register set
   // registers[0x07] = 0xBC04; //Enable the oscillator, from AN230 page 9, rev 0.5 (DOES NOT WORK, wtf Silicon Labs datasheet?)
@@ -303,9 +303,7 @@ void SI4703::setFrequency(RADIO_FREQ newF) {
   registers[CHANNEL] |= channel;      // Mask in the new channel
   registers[CHANNEL] |= (1 << TUNE);  // Set the TUNE bit to start
   _saveRegisters();
-  if (_sendRDS) {
-    _sendRDS(0, 0, 0, 0);
-  }
+  clearRDS();
   _waitEnd();
 }  // setFrequency()
 
@@ -327,13 +325,16 @@ void SI4703::seekDown(bool toNextSender) {
 // Load all status registers from to the chip
 void SI4703::_readRegisters() {
   // Si4703 begins reading from register upper register of 0x0A and reads to 0x0F, then loops to 0x00.
-  _i2cPort->requestFrom(_i2caddr, 32);  // We want to read the entire register set from 0x0A to 0x09 = 32 bytes.
+  uint8_t data[32];
+  _bus->transfer(_i2caddr, nullptr, 0, data, sizeof(data));  // We want to read the entire register set from 0x0A to 0x09 = 32 bytes.
 
   // Remember, register 0x0A comes in first so we have to shuffle the array around a bit
+  uint8_t *d = data;
   for (int x = 0x0A;; x++) {  // Read in these 32 bytes
     if (x == 0x10)
       x = 0;  // Loop back to zero
-    registers[x] = _read16HL(_i2cPort);
+    registers[x] = _read16HL(d);
+    d += 2;
     if (x == 0x09)
       break;  // We're done!
   }           // for
@@ -342,8 +343,9 @@ void SI4703::_readRegisters() {
 
 // Load all status registers from to the chip
 void SI4703::_readRegister0A() {
-  _i2cPort->requestFrom(_i2caddr, 2);  // We want to read the entire register set from 0x0A to 0x09 = 32 bytes.
-  registers[0x0A] = _read16HL(_i2cPort);
+  uint8_t data[2];
+  _bus->transfer(_i2caddr, nullptr, 0, data, sizeof(data));  // We only want to read the register 0x0A.
+  registers[0x0A] = _read16HL(data);
 }  // _readRegister0A()
 
 
@@ -355,19 +357,16 @@ void SI4703::_saveRegisters() {
   // It's a little weird, you don't write an I2C addres
   // The Si4703 assumes you are writing to 0x02 first, then increments
 
-  _i2cPort->beginTransmission(_i2caddr);
   // A write command automatically begins with register 0x02 so no need to send a write-to address
   // First we send the 0x02 to 0x07 control registers
   // In general, we should not write to registers 0x08 and 0x09
+  uint8_t data[6 * 2];
   for (int regSpot = 0x02; regSpot < 0x08; regSpot++) {
-    _write16HL(_i2cPort, registers[regSpot]);
+    _write16HL(data + 2 * (regSpot - 0x02), registers[regSpot]);
   }
 
-  // End this transmission
-  byte ack = _i2cPort->endTransmission();
-  if (ack != 0) {                 // We have a problem!
-    Serial.print("Write Fail:");  // No ACK!
-    Serial.println(ack, DEC);     // I2C error: 0 = success, 1 = data too long, 2 = rx NACK on address, 3 = rx NACK on data, 4 = other error
+  if (_bus->transfer(_i2caddr, data, sizeof(data), nullptr, 0) < 0) {  // We have a problem!
+    Serial.println("Write Fail");                                        // No ACK!
   }
 }  // _saveRegisters
 
@@ -408,10 +407,11 @@ void SI4703::checkRDS() {
   // DEBUG_FUNC0("checkRDS");
   unsigned long now = millis();
 
-  // check if there is a listener !
-  if ((_sendRDS) && (now > _lastRDSPoll + 40)) {
+  // check if there is a listener and polling is due !
+  // The RDSR bit stays on for 40 msec so the same group is not read twice.
+  if (((_sendRDS) || (_sendRDSExt)) && (_rdsPollDue()) && (now - _lastRDSPoll > 40)) {
+    bool received = false;
     _readRegister0A();
-    _lastRDSPoll = now;
 
     // int r1 = registers[STATUSRSSI];
     // _readRegisters();
@@ -423,12 +423,13 @@ void SI4703::checkRDS() {
     if (registers[STATUSRSSI] & RDSR) {
       _readRegisters();
       _lastRDSPoll = now;
+      // BLERA..BLERD are part of the same register read
       uint8_t errA = (registers[STATUSRSSI] >> 9) & 3;
       uint8_t errB = (registers[READCHAN] >> 14) & 3;
       uint8_t errC = (registers[READCHAN] >> 12) & 3;
       uint8_t errD = (registers[READCHAN] >> 10) & 3;
-      if ((errA != 3) && (errB != 3) && (errC != 3) && (errD != 3))
-        _sendRDS(registers[RDSA], registers[RDSB], registers[RDSC], registers[RDSD]);
+      _receiveRDS(registers[RDSA], registers[RDSB], registers[RDSC], registers[RDSD], RDS_PACKERRORS(errA, errB, errC, errD));
+      received = true;
       /*
       Serial.print(" = 0x"); _printHex4( (registers[STATUSRSSI] >> 9)&3 ); Serial.print(' ');
       Serial.print(" = 0x"); _printHex4( (registers[READCHAN] >> 14)&3 ); Serial.print(' ');
@@ -436,6 +437,7 @@ void SI4703::checkRDS() {
       Serial.print(" = 0x"); _printHex4( (registers[READCHAN] >> 10)&3 ); Serial.println();
       */
     }  // if
+    _rdsPollDone(received);
   }    // if
 }  // checkRDS
 
@@ -496,20 +498,23 @@ void SI4703::_seek(bool seekUp) {
   // save the registers and start seeking...
   registers[POWERCFG] = reg;
   _saveRegisters();
-  if (_sendRDS) {
-    _sendRDS(0, 0, 0, 0);
-  }
+  clearRDS();
   _waitEnd();
 }  // _seek
 
 
 /// wait until the current seek and tune operation is over.
+/// The operation is stopped early when a new frequency is requested.
 void SI4703::_waitEnd() {
   DEBUG_FUNC0("_waitEnd");
 
   // wait until STC gets high
   do {
     _readRegister0A();
+    if (_tuneAbort()) {
+      DEBUG_STR("Tune stopped");
+      break;
+    }
     delay(10);
   } while ((registers[STATUSRSSI] & STC) == 0);
 
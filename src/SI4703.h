@@ -16,6 +16,9 @@
 /// --------
 /// * 05.08.2014 created.
 /// * 05.02.2023 clearing RDS data after frequency changes and scan.
+/// * 18.10.2026 RDS groups are passed with the block error levels.
+/// * 18.10.2026 RDS polling by the adaptive scheduler.
+/// * 18.10.2026 a running tune or seek is stopped by a new frequency request.
 
 #ifndef SI4703_h
 #define SI4703_h
@@ -101,7 +104,7 @@ private:
   // store the current values of the 16 chip internal 16-bit registers
   uint16_t registers[16];
 
-  // last RDS Poll to prevent polling < 40 
+  // last received RDS group to prevent reading the same group within 40 msec.
   unsigned long _lastRDSPoll = 0;
 
   // ----- low level communication to the chip using I2C bus
@@ -134,7 +134,7 @@ bool SI4705::init() {
   RADIO::init();  // will create reset impulse
 
   // Now that the unit is reset and I2C inteface mode, we need to begin I2C
-  Wire.begin();
+  _bus->begin();
 
   // powering up is done by specifying the band etc. so it's implemented in setBand
   setBand(RADIO_BAND_FM);
@@ -364,32 +364,19 @@ void SI4705::seekDown(bool toNextSender) {
 
 /// Load the status information from to the chip.
 uint8_t SI4705::_readStatus() {
-  uint8_t value;
-
-  Wire.beginTransmission(SI4705_ADR);
-  Wire.write(CMD_GET_INT_STATUS);
-  Wire.endTransmission();
-
-  Wire.requestFrom(SI4705_ADR, 1);  // We want to read 1 byte only.
-  value = Wire.read();
+  uint8_t cmd = CMD_GET_INT_STATUS;
+  uint8_t value = 0;
 
+  _bus->transfer(SI4705_ADR, &cmd, 1, &value, 1);  // We want to read 1 byte only.
   return (value);
 }  // _readStatus()
 
 
 /// Load status information from to the chip.
 void SI4705::_readStatusData(uint8_t cmd, uint8_t param, uint8_t *values, uint8_t len) {
-  Wire.beginTransmission(SI4705_ADR);
-  Wire.write(cmd);
-  Wire.write(param);
+  uint8_t cmdData[2] = { cmd, param };
 
-  Wire.endTransmission();
-  Wire.requestFrom(SI4705_ADR, (int)len);  // We want to read some bytes.
-
-  for (uint8_t n = 0; n < len; n++) {
-    // Read in these bytes
-    values[n] = Wire.read();
-  }  // for
+  _bus->transfer(SI4705_ADR, cmdData, sizeof(cmdData), values, len);  // We want to read some bytes.
 }  // _readStatusData()
 
 
@@ -420,23 +407,29 @@ void SI4705::getAudioInfo(AUDIO_INFO *info) {
 
 /// Retrieve the next RDS data if available.
 void SI4705::checkRDS() {
-  if (_sendRDS) {
+  if (((_sendRDS) || (_sendRDSExt)) && (_rdsPollDue())) {
     // fetch the interrupt status first
     _readStatus();
 
     // fetch the current RDS data
     _readStatusData(CMD_FM_RDS_STATUS, 0x01, rdsStatus.buffer, sizeof(rdsStatus));
 
-    if ((rdsStatus.resp2 = 0x01) && (rdsStatus.rdsFifoUsed) && (rdsStatus.blockErrors == 0)) {
-      // RDS is in sync, it's a complete entry and no errors
+    if ((rdsStatus.resp2 & 0x01) && (rdsStatus.rdsFifoUsed)) {
+      // RDS is in sync and an entry is available.
+      // blockErrors has the same layout as the packed RDS error levels: BLEA, BLEB, BLEC, BLED.
 
 #define RDSBLOCKWORD(h, l) (h << 8 | l)
 
-      _sendRDS(RDSBLOCKWORD(rdsStatus.blockAH, rdsStatus.blockAL),
-               RDSBLOCKWORD(rdsStatus.blockBH, rdsStatus.blockBL),
-               RDSBLOCKWORD(rdsStatus.blockCH, rdsStatus.blockCL),
-               RDSBLOCKWORD(rdsStatus.blockDH, rdsStatus.blockDL));
+      _receiveRDS(RDSBLOCKWORD(rdsStatus.blockAH, rdsStatus.blockAL),
+                  RDSBLOCKWORD(rdsStatus.blockBH, rdsStatus.blockBL),
+                  RDSBLOCKWORD(rdsStatus.blockCH, rdsStatus.blockCL),
+                  RDSBLOCKWORD(rdsStatus.blockDH, rdsStatus.blockDL),
+                  rdsStatus.blockErrors);
     }  // if
+
+    // more groups in the FIFO are read by the next call.
+    if (rdsStatus.rdsFifoUsed <= 1)
+      _rdsPollDone((rdsStatus.resp2 & 0x01) && (rdsStatus.rdsFifoUsed));
   }    // if _sendRDS
 }  // checkRDS()
 
@@ -529,22 +522,19 @@ void SI4705::_sendCommand(int cnt, int cmd, ...) {
     Serial.println("error: _sendCommand: too much parameters!");
 
   } else {
-    Wire.beginTransmission(SI4705_ADR);
-    Wire.write(cmd);
+    uint8_t cmdData[8];
+    cmdData[0] = cmd;
 
     va_list params;
     va_start(params, cmd);
 
     for (uint8_t i = 1; i < cnt; i++) {
-      uint8_t c = va_arg(params, int);
-      Wire.write(c);
+      cmdData[i] = va_arg(params, int);
     }
-    Wire.endTransmission();
     va_end(params);
 
-    // wait for Command being processed
-    Wire.requestFrom(SI4705_ADR, 1);  // We want to read the status byte.
-    _status = Wire.read();
+    // send the command and read the status byte.
+    _bus->transfer(SI4705_ADR, cmdData, cnt, &_status, 1);
   }  // if
 
 }  // _sendCommand()
@@ -552,19 +542,10 @@ void SI4705::_sendCommand(int cnt, int cmd, ...) {
 
 /// Set a property in the radio chip
 void SI4705::_setProperty(uint16_t prop, uint16_t value) {
-  Wire.beginTransmission(SI4705_ADR);
-  Wire.write(CMD_SET_PROPERTY);
-  Wire.write(0);
-
-  Wire.write(prop >> 8);
-  Wire.write(prop & 0x00FF);
-  Wire.write(value >> 8);
-  Wire.write(value & 0x00FF);
-
-  Wire.endTransmission();
+  uint8_t cmdData[6] = { CMD_SET_PROPERTY, 0, (uint8_t)(prop >> 8), (uint8_t)(prop & 0x00FF), (uint8_t)(value >> 8), (uint8_t)(value & 0x00FF) };
 
-  Wire.requestFrom(SI4705_ADR, 1);  // We want to read the status byte.
-  _status = Wire.read();
+  // send the property and read the status byte.
+  _bus->transfer(SI4705_ADR, cmdData, sizeof(cmdData), &_status, 1);
 }  // _setProperty()
 
 
@@ -19,6 +19,8 @@
 /// * 15.02.2015 RDS is working.
 /// * 27.03.2015 scanning is working. No changes to default settings needed.
 /// * 03.05.2015 softmute is working. 
+/// * 18.10.2026 RDS groups are passed with the block error levels.
+/// * 18.10.2026 RDS polling by the adaptive scheduler.
 
 
 #ifndef SI4705_h
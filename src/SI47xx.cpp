@@ -212,6 +212,64 @@
 #define PROP_TX_PREEMPHASIS_75 0x00
 
 
+// ----- property shadow table -----
+
+/// A property and its default value after power up.
+struct SI47xxProperty {
+  uint16_t prop;
+  uint16_t value;
+};
+
+/// The properties in the shadow table with the default values from AN332.
+static const SI47xxProperty propDefaults[] PROGMEM = {
+  { PROP_GPO_IEN, 0x0000 },
+  { PROP_REFCLK_FREQ, 0x8000 },  // 32768 Hz
+  { PROP_FM_DEEMPHASIS, PROP_FM_DEEMPHASIS_75 },
+  { PROP_FM_BLEND_STEREO_THRESHOLD, 0x0031 },  // 49 dBμV
+  { PROP_FM_ANTENNA_INPUT, PROP_FM_ANTENNA_INPUT_FMI },
+  { FM_SOFT_MUTE_MAX_ATTENUATION, 0x0010 },
+  { PROP_FM_SEEK_FREQ_SPACING, 0x000A },  // 100 kHz
+  { FM_SEEK_TUNE_SNR_THRESHOLD, 0x0003 },
+  { FM_SEEK_TUNE_RSSI_TRESHOLD, 0x0014 },
+  { PROP_RDS_INTERRUPT_SOURCE, 0x0000 },
+  { PROP_RDS_INT_FIFO_COUNT, 0x0000 },
+  { PROP_RDS_CONFIG, 0x0000 },
+  { PROP_RX_VOLUME, 0x003F },
+  { PROP_RX_HARD_MUTE, 0x0000 },
+
+  { PROP_TX_COMPONENT_ENABLE, 0x0003 },  // pilot and stereo
+  { PROP_TX_AUDIO_DEVIATION, 0x1AA9 },   // 68.25 kHz
+  { PROP_TX_RDS_DEVIATION, 0x00C8 },     // 2 kHz
+  { PROP_TX_PREEMPHASIS, PROP_TX_PREEMPHASIS_75 },
+  { PROP_TX_ACOMP_ENABLE, 0x0002 },  // limiter on
+  { PROP_TX_ACOMP_GAIN, 0x000F },
+  { PROP_TX_RDS_INTERRUPT_SOURCE, 0x0000 },
+  { PROP_TX_RDS_PI, 0x40A7 },
+  { PROP_TX_RDS_PS_MIX, 0x0003 },
+  { PROP_TX_RDS_PS_MISC, 0x1008 },
+  { PROP_TX_RDS_PS_REPEAT_COUNT, 0x0003 },
+  { PROP_TX_RDS_MESSAGE_COUNT, 0x0001 },
+  { PROP_TX_RDS_PS_AF, 0xE0E0 },
+  { PROP_TX_RDS_FIFO_SIZE, 0x0000 }
+};
+
+#define PROP_COUNT (sizeof(propDefaults) / sizeof(SI47xxProperty))
+
+// max. time in msec to wait for CTS, the POWER_UP command takes up to 110 msec.
+#define CTS_TIMEOUT 500
+
+// Size of the RDS FIFO in blocks: one more than 4 groups of 3 blocks.
+#define TX_RDS_FIFO_BLOCKS 13
+
+// RDS group types used in transmit mode.
+#define RDS_GROUP_2A 0x20
+#define RDS_GROUP_4A 0x40
+#define RDS_GROUP_10A 0xA0
+
+// Build a RDS block from 2 characters.
+#define RDS_CHARS(s, i) ((uint16_t)(((uint8_t)(s)[i] << 8) | (uint8_t)(s)[(i) + 1]))
+
+
 // #define ELVRADIO
 
 /// Initialize the extra variables in SI47xx
@@ -219,6 +277,9 @@ SI47xx::SI47xx() {
   _txPower = 90;
   // maximum volume level of the chip.
   _maxVolume = 63;
+  static_assert(PROP_COUNT <= sizeof(_propValues) / sizeof(_propValues[0]), "shadow table too small");
+  static_assert(PROP_COUNT <= 32, "pending mask too small");
+  _resetProperties();
 }
 
 
@@ -240,25 +301,25 @@ bool SI47xx::init() {
   RADIO::init();  // will create reset impulse
 
   // Now that the unit is reset and I2C interface mode, we need to begin I2C
-  _i2cPort->begin();
+  _bus->begin();
 
   // see if a chip can be found
   if (_i2caddr == 0) {
     // check some known addresses
-    // if (RADIO::_wireExists(_i2cPort, SI47xx_ADR0)) {
+    // if (RADIO::_wireExists(_bus, SI47xx_ADR0)) {
     //   deviceAddress = SI47xx_ADR0;
     // } else
-    if (RADIO::_wireExists(_i2cPort, SI47xx_ADR1)) {
+    if (RADIO::_wireExists(_bus, SI47xx_ADR1)) {
       _i2caddr = SI47xx_ADR1;
-    } else if (RADIO::_wireExists(_i2cPort, SI47xx_ADR2)) {
+    } else if (RADIO::_wireExists(_bus, SI47xx_ADR2)) {
       _i2caddr = SI47xx_ADR2;
-    } else if (RADIO::_wireExists(_i2cPort, SI47xx_ADR3)) {
+    } else if (RADIO::_wireExists(_bus, SI47xx_ADR3)) {
       _i2caddr = SI47xx_ADR3;
     } else {
       found = false;
     }
   } else {
-    found = RADIO::_wireExists(_i2cPort, _i2caddr);
+    found = RADIO::_wireExists(_bus, _i2caddr);
   }  // if
   DEBUG_FUNC1X("I2C-address=", _i2caddr);
 
@@ -271,6 +332,7 @@ bool SI47xx::init() {
 /// @return void
 void SI47xx::term() {
   _sendCommand(1, CMD_POWER_DOWN);
+  _resetProperties();
 }  // term
 
 
@@ -282,6 +344,7 @@ void SI47xx::setVolume(int8_t newVolume) {
   DEBUG_FUNC1("setVolume", newVolume);
   RADIO::setVolume(newVolume); // will constrain the _volume in the range 0.._maxVolume
   _setProperty(PROP_RX_VOLUME, newVolume);
+  _flushProperties();
 }  // setVolume()
 
 
@@ -300,6 +363,7 @@ void SI47xx::setMute(bool switchOn) {
     // clear mute bits in the fm receiver
     _setProperty(PROP_RX_HARD_MUTE, 0x00);
   }  // if
+  _flushProperties();
 }  // setMute()
 
 
@@ -325,6 +389,7 @@ void SI47xx::setSoftMute(bool switchOn) {
     // to disable the softmute mode the attenuation is set to 0.
     _setProperty(FM_SOFT_MUTE_MAX_ATTENUATION, 0x00);
   }
+  _flushProperties();
 }  // setSoftMute()
 
 
@@ -357,6 +422,7 @@ void SI47xx::setMono(bool switchOn) {
       _setProperty(PROP_FM_BLEND_STEREO_THRESHOLD, 49);  // default = 49 dBμV
     }                                                    // if
   }                                                      // if
+  _flushProperties();
 }  // setMono
 
 
@@ -371,8 +437,9 @@ void SI47xx::setMono(bool switchOn) {
 void SI47xx::setBand(RADIO_BAND newBand) {
   DEBUG_FUNC1("setBand", newBand);
 
-  // Power down the device
+  // Power down the device, all properties will have the default values after power up.
   _sendCommand(1, CMD_POWER_DOWN);
+  _resetProperties();
   // Give the device some time to power down before restart
   delay(500);
 
@@ -395,7 +462,8 @@ void SI47xx::setBand(RADIO_BAND newBand) {
     // query chip
     if (1) {
       uint8_t values[15];
-      _wireRead(_i2cPort, _i2caddr, CMD_GET_REV, values, sizeof(values));
+      uint8_t cmd = CMD_GET_REV;
+      _transferCTS(&cmd, 1, values, sizeof(values));
       uint8_t chip = values[1];
       DEBUG_VAL("Chip SI47xx", chip);
 
@@ -430,6 +498,7 @@ void SI47xx::setBand(RADIO_BAND newBand) {
     _setProperty(PROP_GPO_IEN, 0);  // no interrupts
     // _setProperty(PROP_GPO_IEN, PROP_GPO_IEN_STCIEN);
     // _setProperty(PROP_GPO_IEN, PROP_GPO_IEN_STCIEN | PROP_GPO_IEN_RDSIEN); //  | PROP_GPO_IEN_RDSIEN ????
+    _flushProperties();
 
   } else if (newBand == RADIO_BAND_FMTX) {
     RADIO::setBand(newBand);
@@ -469,6 +538,7 @@ void SI47xx::setBand(RADIO_BAND newBand) {
     // _setProperty(PROP_TX_LINE_INPUT_MUTE, 0x0000);
     // _setProperty(PROP_TX_LINE_INPUT_LEVEL, PROP_TX_LINE_INPUT_LEVEL_60 | 0x27C); // not too sensitive
   }  // if
+  _flushProperties();
 }  // setBand()
 
 
@@ -568,7 +638,8 @@ void SI47xx::seekDown(bool toNextSender) {
 /// Load the status information from to the chip.
 uint8_t SI47xx::_readStatus() {
   uint8_t data[1];
-  _wireRead(_i2cPort, _i2caddr, CMD_GET_INT_STATUS, data, 1);
+  uint8_t cmd = CMD_GET_INT_STATUS;
+  _transferCTS(&cmd, 1, data, 1);
   return (data[0]);
 }  // _readStatus()
 
@@ -576,7 +647,7 @@ uint8_t SI47xx::_readStatus() {
 /// Load status information from to the chip.
 void SI47xx::_readStatusData(uint8_t cmd, uint8_t param, uint8_t *values, uint8_t len) {
   uint8_t buffer[2] = { cmd, param };
-  _wireRead(_i2cPort, _i2caddr, buffer, 2, values, len);
+  _transferCTS(buffer, 2, values, len);
 }  // _readStatusData()
 
 
@@ -615,31 +686,53 @@ void SI47xx::attachReceiveRDS(receiveRDSFunction newFunction) {
   DEBUG_FUNC0("attachReceiveRDS");
 
   if (_hasRDS) {
-    // enable RDS
-    _setProperty(PROP_RDS_INTERRUPT_SOURCE, PROP_RDS_INTERRUPT_SOURCE_RDSRECV);  // Set the CTS status bit after receiving RDS data.
-    _setProperty(PROP_RDS_INT_FIFO_COUNT, 4);
-    _setProperty(PROP_RDS_CONFIG, 0xFF01);  // accept all correctable data and enable rds
-
+    _enableRDS();
     RADIO::attachReceiveRDS(newFunction);
   }
-}
+}  // attachReceiveRDS()
+
+
+// initialize RDS mode for receiving groups with error levels
+void SI47xx::attachReceiveRDSExt(receiveRDSExtFunction newFunction) {
+  DEBUG_FUNC0("attachReceiveRDSExt");
+
+  if (_hasRDS) {
+    _enableRDS();
+    RADIO::attachReceiveRDSExt(newFunction);
+  }
+}  // attachReceiveRDSExt()
+
+
+// enable RDS in the chip
+void SI47xx::_enableRDS() {
+  _setProperty(PROP_RDS_INTERRUPT_SOURCE, PROP_RDS_INTERRUPT_SOURCE_RDSRECV);  // Set the CTS status bit after receiving RDS data.
+  _setProperty(PROP_RDS_INT_FIFO_COUNT, 4);
+  _setProperty(PROP_RDS_CONFIG, 0xFF01);  // accept all correctable data and enable rds
+  _flushProperties();
+}  // _enableRDS()
 
 /// Retrieve the next RDS data if available.
 void SI47xx::checkRDS() {
-  if ((_hasRDS) && (_sendRDS)) {
+  if ((_hasRDS) && ((_sendRDS) || (_sendRDSExt)) && (_rdsPollDue())) {
     // fetch the current RDS data
     _readStatusData(CMD_FM_RDS_STATUS, 0x01, rdsStatus.buffer, sizeof(rdsStatus));
 
-    if ((rdsStatus.resp2 = 0x01) && (rdsStatus.rdsFifoUsed) && (rdsStatus.blockErrors == 0)) {
-      // RDS is in sync, it's a complete entry and no errors
+    if ((rdsStatus.resp2 & 0x01) && (rdsStatus.rdsFifoUsed)) {
+      // RDS is in sync and an entry is available.
+      // blockErrors has the same layout as the packed RDS error levels: BLEA, BLEB, BLEC, BLED.
 
 #define RDSBLOCKWORD(h, l) (h << 8 | l)
 
-      _sendRDS(RDSBLOCKWORD(rdsStatus.blockAH, rdsStatus.blockAL),
-               RDSBLOCKWORD(rdsStatus.blockBH, rdsStatus.blockBL),
-               RDSBLOCKWORD(rdsStatus.blockCH, rdsStatus.blockCL),
-               RDSBLOCKWORD(rdsStatus.blockDH, rdsStatus.blockDL));
+      _receiveRDS(RDSBLOCKWORD(rdsStatus.blockAH, rdsStatus.blockAL),
+                  RDSBLOCKWORD(rdsStatus.blockBH, rdsStatus.blockBL),
+                  RDSBLOCKWORD(rdsStatus.blockCH, rdsStatus.blockCL),
+                  RDSBLOCKWORD(rdsStatus.blockDH, rdsStatus.blockDL),
+                  rdsStatus.blockErrors);
     }  // if
+
+    // more groups in the FIFO are read by the next call.
+    if (rdsStatus.rdsFifoUsed <= 1)
+      _rdsPollDone((rdsStatus.resp2 & 0x01) && (rdsStatus.rdsFifoUsed));
   }    // if _sendRDS
 }  // checkRDS()
 
@@ -666,18 +759,20 @@ void SI47xx::setTXPower(uint8_t pwr) {
 /// @param programID Optional 4 character hexadecimal ID
 /// @return void
 void SI47xx::beginRDS(uint16_t programID) {
+  _rdsPI = programID;
 
   _setProperty(PROP_TX_AUDIO_DEVIATION, 6625);         // 66.25KHz (default is 68.25)
   _setProperty(PROP_TX_RDS_DEVIATION, 200);            // 2KHz (default)
   _setProperty(PROP_TX_RDS_INTERRUPT_SOURCE, 0x0001);  // RDS IRQ
   _setProperty(PROP_TX_RDS_PI, programID);             // program identifier
   _setProperty(PROP_TX_RDS_PS_MIX, 0x03);              // 50% mix (default)
-  _setProperty(PROP_TX_RDS_PS_MISC, 0x1808);           // RDSD0 & RDSMS (default)
+  _setProperty(PROP_TX_RDS_PS_MISC, 0x1808 | (_rdsPTY << 5));  // RDSD0, FORCEB & RDSMS with program type
   _setProperty(PROP_TX_RDS_PS_REPEAT_COUNT, 3);        // 3 repeats (default)
   _setProperty(PROP_TX_RDS_MESSAGE_COUNT, 1);
   _setProperty(PROP_TX_RDS_PS_AF, 0xE0E0);  // no AF
-  _setProperty(PROP_TX_RDS_FIFO_SIZE, 0);
+  _setProperty(PROP_TX_RDS_FIFO_SIZE, TX_RDS_FIFO_BLOCKS);  // FIFO for clock time groups
   _setProperty(PROP_TX_COMPONENT_ENABLE, 0x0007);
+  _flushProperties();
 }
 
 /// Set the RDS station name string. \n
@@ -687,33 +782,117 @@ void SI47xx::beginRDS(uint16_t programID) {
 /// @param *s string containing your 8 character name
 /// @return void
 void SI47xx::setRDSstation(char *s) {
-  uint8_t len = strlen(s);
-  uint8_t slots = (len + 3) / 4;
-
-  for (uint8_t i = 0; i < slots; i++) {
-    uint8_t psChar[4] = { ' ', ' ', ' ', ' ' };
-    memcpy(psChar, s, min(4, (int)strlen(s)));  // copy from index of string s to the minimum of 4 or the length of s
-    s += 4;                                     // advance index of s by 4
-    _sendCommand(6, CMD_TX_RDS_PS, i, psChar[0], psChar[1], psChar[2], psChar[3], 0);
+  char ps[8];
+
+  // the name is always padded to 8 characters so no old characters remain.
+  memset(ps, ' ', sizeof(ps));
+  memcpy(ps, s, min(8, (int)strlen(s)));
+
+  for (uint8_t i = 0; i < 2; i++) {
+    _sendCommand(6, CMD_TX_RDS_PS, i, ps[4 * i], ps[4 * i + 1], ps[4 * i + 2], ps[4 * i + 3]);
   }
-}
+}  // setRDSstation()
+
 
 /// Load new data into RDS Radio Text Buffer.
 /// @param *s string containing arbitrary text to be transmitted as RDS Radio Text
 /// @return void
 void SI47xx::setRDSbuffer(char *s) {
-  uint8_t len = strlen(s);
-  uint8_t slots = (len + 3) / 4;
-
-  for (uint8_t i = 0; i < slots; i++) {
-    uint8_t rdsBuff[4] = { ' ', ' ', ' ', ' ' };
-    memcpy(rdsBuff, s, min(4, (int)strlen(s)));
-    s += 4;
-    _sendCommand(8, CMD_TX_RDS_BUFF, i == 0 ? 0x06 : 0x04, 0x20, i, rdsBuff[0], rdsBuff[1], rdsBuff[2], rdsBuff[3], 0);
+  setRDSText(s);
+}  // setRDSbuffer()
+
+
+/// Set the program type that is sent in all groups.
+/// @param pty program type 0..31
+void SI47xx::setRDSPTY(uint8_t pty) {
+  _rdsPTY = pty & 0x1F;
+  _setProperty(PROP_TX_RDS_PS_MISC, 0x1808 | (_rdsPTY << 5));
+  _loadRDSBuffer();
+}  // setRDSPTY()
+
+
+/// Set the program type name that is sent in 10A groups.
+/// @param ptyn program type name with max. 8 characters, an empty string to stop sending 10A groups.
+void SI47xx::setRDSPTYN(const char *ptyn) {
+  strncpy(_rdsPTYN, ptyn, sizeof(_rdsPTYN) - 1);
+  _rdsPTYN[sizeof(_rdsPTYN) - 1] = '\0';
+  _loadRDSBuffer();
+}  // setRDSPTYN()
+
+
+/// Set the RadioText that is sent in 2A groups.
+/// The transmitted segments are compared with the new ones and nothing is sent when no segment has changed.
+/// The A/B flag is toggled for every new message so receivers clear the old text.
+/// The circular buffer of the chip cannot be updated partially so a changed text is loaded completely.
+/// @param text RadioText with max. 64 characters.
+/// @return number of bus commands saved.
+uint8_t SI47xx::setRDSText(const char *text) {
+  char oldSegs[64], newSegs[64];
+  uint8_t oldCount = _rdsTextSegments(_rdsText, oldSegs);
+  uint8_t newCount = _rdsTextSegments(text, newSegs);
+  uint8_t changed = 0;
+  uint8_t saved = 0;
+
+  for (uint8_t i = 0; i < newCount; i++) {
+    if ((i >= oldCount) || (memcmp(&oldSegs[4 * i], &newSegs[4 * i], 4) != 0)) changed++;
   }
 
+  if ((changed == 0) && (newCount == oldCount)) {
+    // unchanged: nothing to send.
+    saved = newCount;
+    _rdsCommandsSaved += saved;
+
+  } else {
+    _rdsTextAB = !_rdsTextAB;
+    strncpy(_rdsText, text, sizeof(_rdsText) - 1);
+    _rdsText[sizeof(_rdsText) - 1] = '\0';
+    _loadRDSBuffer();
+  }  // if
+
   _setProperty(PROP_TX_COMPONENT_ENABLE, 0x0007);  // stereo, pilot+rds
-}
+  _flushProperties();
+  return (saved);
+}  // setRDSText()
+
+
+/// Send the clock time in a 4A group through the FIFO of the chip.
+/// The FIFO groups are sent with priority and only once.
+/// @param time the current UTC time and local offset.
+void SI47xx::setRDSTime(RDS_TIME *time) {
+  // Modified Julian Day, see IEC 62106 annex G.
+  uint16_t y = time->year - 1900;
+  uint8_t l = (time->month <= 2) ? 1 : 0;
+  uint32_t mjd = 14956UL + time->day + ((uint32_t)(y - l) * 1461UL) / 4 + ((uint32_t)(time->month + 1 + l * 12) * 306001UL) / 10000UL;
+
+  uint8_t offset = (time->offset < 0) ? (0x20 | (-time->offset & 0x1F)) : (time->offset & 0x1F);
+
+  _loadRDSGroup(CMD_TX_RDS_BUFF_IN_FIFO | CMD_TX_RDS_BUFF_IN_LDBUFF,
+                _rdsBlockB(RDS_GROUP_4A, (mjd >> 15) & 0x03),
+                ((mjd & 0x7FFF) << 1) | (time->hour >> 4),
+                ((time->hour & 0x0F) << 12) | (time->minute << 6) | offset);
+  _rdsTimeMinute = time->minute;
+}  // setRDSTime()
+
+
+/// Register the function that is used to retrieve the current time for sending clock time groups.
+void SI47xx::attachRDSTimeSource(rdsTimeSourceFunction newFunction) {
+  _rdsTimeSource = newFunction;
+  _rdsTimeMinute = 0xFF;
+}  // attachRDSTimeSource()
+
+
+/// Check the time source every second and send a new clock time when the minute has changed.
+void SI47xx::checkRDSTX() {
+  unsigned long now = millis();
+
+  if ((_rdsTimeSource) && (now - _rdsTimeCheck >= 1000)) {
+    RDS_TIME time;
+    _rdsTimeCheck = now;
+    if ((_rdsTimeSource(&time)) && (time.minute != _rdsTimeMinute)) {
+      setRDSTime(&time);
+    }
+  }  // if
+}  // checkRDSTX()
 
 /// Get TX Status and Audio Input Metrics
 /// @param void
@@ -721,14 +900,10 @@ void SI47xx::setRDSbuffer(char *s) {
 ASQ_STATUS SI47xx::getASQ() {
   _sendCommand(2, CMD_TX_ASQ_STATUS, 0x1);
 
-  _i2cPort->requestFrom((uint8_t)_i2caddr, (uint8_t)5);
-
   ASQ_STATUS result;
 
   uint8_t response[5];
-  for (uint8_t i = 0; i < 5; i++) {
-    response[i] = _i2cPort->read();
-  }
+  _bus->transfer(_i2caddr, nullptr, 0, response, sizeof(response));
 
   result.asq = response[1];
   result.audioInLevel = response[4];
@@ -742,14 +917,10 @@ ASQ_STATUS SI47xx::getASQ() {
 TX_STATUS SI47xx::getTuneStatus() {
   _sendCommand(2, CMD_TX_TUNE_STATUS, 0x1);
 
-  _i2cPort->requestFrom((uint8_t)_i2caddr, (uint8_t)8);
-
   TX_STATUS result;
 
   uint8_t response[8];
-  for (uint8_t i = 0; i < 8; i++) {
-    response[i] = _i2cPort->read();
-  }
+  _bus->transfer(_i2caddr, nullptr, 0, response, sizeof(response));
 
   result.frequency = response[2];
   result.frequency <<= 8;
@@ -761,6 +932,64 @@ TX_STATUS SI47xx::getTuneStatus() {
   return result;
 }
 
+// ----- RDS transmit scheduler -----
+
+/// Build block B with group type, version A and program type.
+/// @param groupType group type in the upper 4 bits and the version bit.
+/// @param bits the group specific lower 5 bits.
+uint16_t SI47xx::_rdsBlockB(uint8_t groupType, uint16_t bits) {
+  return (((uint16_t)groupType << 8) | (_rdsPTY << 5) | (bits & 0x1F));
+}  // _rdsBlockB()
+
+
+/// Load one group into the chip.
+void SI47xx::_loadRDSGroup(uint8_t flags, uint16_t blockB, uint16_t blockC, uint16_t blockD) {
+  _sendCommand(8, CMD_TX_RDS_BUFF, flags,
+               blockB >> 8, blockB & 0xFF, blockC >> 8, blockC & 0xFF, blockD >> 8, blockD & 0xFF);
+}  // _loadRDSGroup()
+
+
+/// Load the RadioText and PTYN groups into the circular buffer.
+/// The first group empties the buffer.
+void SI47xx::_loadRDSBuffer() {
+  uint8_t flags = CMD_TX_RDS_BUFF_IN_MTBUFF | CMD_TX_RDS_BUFF_IN_LDBUFF;
+  char text[64];
+  uint8_t segments = _rdsTextSegments(_rdsText, text);
+
+  for (uint8_t i = 0; i < segments; i++) {
+    _loadRDSGroup(flags, _rdsBlockB(RDS_GROUP_2A, (_rdsTextAB ? 0x10 : 0x00) | i), RDS_CHARS(text, 4 * i), RDS_CHARS(text, 4 * i + 2));
+    flags = CMD_TX_RDS_BUFF_IN_LDBUFF;
+  }
+
+  if (_rdsPTYN[0]) {
+    char ptyn[8];
+    memset(ptyn, ' ', sizeof(ptyn));
+    memcpy(ptyn, _rdsPTYN, strlen(_rdsPTYN));
+
+    for (uint8_t i = 0; i < 2; i++) {
+      _loadRDSGroup(flags, _rdsBlockB(RDS_GROUP_10A, i), RDS_CHARS(ptyn, 4 * i), RDS_CHARS(ptyn, 4 * i + 2));
+      flags = CMD_TX_RDS_BUFF_IN_LDBUFF;
+    }
+  }  // if
+
+  if (flags & CMD_TX_RDS_BUFF_IN_MTBUFF) {
+    // nothing to send: just empty the buffer.
+    _sendCommand(2, CMD_TX_RDS_BUFF, CMD_TX_RDS_BUFF_IN_MTBUFF);
+  }
+}  // _loadRDSBuffer()
+
+
+/// The text is ended by a CR when shorter than 64 characters and padded with spaces to full segments.
+uint8_t SI47xx::_rdsTextSegments(const char *text, char *buffer) {
+  uint8_t len = strnlen(text, 64);
+
+  memset(buffer, ' ', 64);
+  memcpy(buffer, text, len);
+  if ((len > 0) && (len < 64)) buffer[len++] = '\r';
+  return ((len + 3) / 4);
+}  // _rdsTextSegments()
+
+
 // ----- Debug functions -----
 
 /// Send the current values of all registers to the Serial port.
@@ -840,6 +1069,27 @@ void SI47xx::debugStatus() {
 }  // debugStatus
 
 
+/// Send the properties from the shadow table to the Serial port.
+/// Properties that differ from the default value are marked by '*', pending properties by '!'.
+void SI47xx::debugProperties() {
+  for (uint8_t n = 0; n < PROP_COUNT; n++) {
+    uint16_t prop = pgm_read_word(&propDefaults[n].prop);
+    uint16_t def = pgm_read_word(&propDefaults[n].value);
+
+    _printHex4(prop);
+    Serial.print('=');
+    _printHex4(_propValues[n]);
+    if (_propValues[n] != def) Serial.print('*');
+    if (_propPending & (1UL << n)) Serial.print('!');
+    Serial.println();
+  }  // for
+  Serial.print("writes=");
+  Serial.print(_propWrites);
+  Serial.print(" skipped=");
+  Serial.println(_propSkips);
+}  // debugProperties()
+
+
 /// wait until the current seek and tune operation is over.
 void SI47xx::_waitEnd() {
   DEBUG_FUNC0("_waitEnd");
@@ -850,6 +1100,9 @@ void SI47xx::_waitEnd() {
 void SI47xx::_sendCommand(int cnt, int cmd, ...) {
   uint8_t cmdData[12];
 
+  // properties are set before the command is executed.
+  _flushProperties();
+
   va_list params;
   va_start(params, cmd);
   cmdData[0] = cmd;
@@ -857,23 +1110,90 @@ void SI47xx::_sendCommand(int cnt, int cmd, ...) {
     cmdData[i] = va_arg(params, int);
   }
 
-  _wireRead(_i2cPort, _i2caddr, cmdData, cnt, &_status, 1);
+  // send the command and wait for command is executed finally.
+  _transferCTS(cmdData, cnt, &_status, 1);
+  if (_wireDebugEnabled) {
+    Serial.print(" =0x");
+    Serial.println(_status, HEX);
+  }
+}  // _sendCommand()
+
+
+/// Set a property in the radio chip.
+/// Properties from the shadow table are only queued when changed.
+void SI47xx::_setProperty(uint16_t prop, uint16_t value) {
+  for (uint8_t n = 0; n < PROP_COUNT; n++) {
+    if (pgm_read_word(&propDefaults[n].prop) == prop) {
+      if (_propValues[n] == value) {
+        _propSkips++;
+      } else {
+        _propValues[n] = value;
+        _propPending |= (1UL << n);
+      }
+      return;
+    }
+  }  // for
+
+  // not in the shadow table: send now but keep the order.
+  _flushProperties();
+  _writeProperty(prop, value);
+}  // _setProperty()
+
 
-  // wait for command is executed finally.
-  while (!(_status & CMD_GET_INT_STATUS_CTS)) {
-    delay(10);
-    _i2cPort->requestFrom((uint8_t)_i2caddr, (uint8_t)1);
-    _status = _i2cPort->read();
-    if (_wireDebugEnabled) {
-      Serial.print(" =0x");
-      Serial.println(_status, HEX);
+/// Send all pending properties to the chip in the order of the shadow table.
+void SI47xx::_flushProperties() {
+  if (_propPending) {
+    uint32_t pending = _propPending;
+    _propPending = 0;
+
+    for (uint8_t n = 0; n < PROP_COUNT; n++) {
+      if (pending & (1UL << n)) {
+        _writeProperty(pgm_read_word(&propDefaults[n].prop), _propValues[n]);
+      }
+    }  // for
+  }    // if
+}  // _flushProperties()
+
+
+/// Reset the shadow table to the default values of the chip.
+/// The chip also clears the RDS buffers at power down so the RDS shadows are cleared too.
+void SI47xx::_resetProperties() {
+  for (uint8_t n = 0; n < PROP_COUNT; n++) {
+    _propValues[n] = pgm_read_word(&propDefaults[n].value);
+  }
+  _propPending = 0;
+
+  _rdsText[0] = '\0';
+  _rdsPTYN[0] = '\0';
+  _rdsTextAB = false;
+  _rdsTimeMinute = 0xFF;
+}  // _resetProperties()
+
+
+/// Send a command and read the response, the chip may not be ready yet.
+bool SI47xx::_transferCTS(uint8_t *cmdData, int cmdLen, uint8_t *data, int len) {
+  if (_bus->transfer(_i2caddr, cmdData, cmdLen, data, len) <= 0) data[0] = 0;
+  return (_waitCTS(data, len));
+}  // _transferCTS()
+
+
+/// Wait for the CTS flag by polling the response without extra delays.
+/// A chip that does not answer is given up after CTS_TIMEOUT.
+bool SI47xx::_waitCTS(uint8_t *data, int len) {
+  unsigned long start = millis();
+  while (!(data[0] & CMD_GET_INT_STATUS_CTS)) {
+    if (millis() - start >= CTS_TIMEOUT) {
+      DEBUG_STR("CTS timeout");
+      return (false);
     }
+    if (_bus->transfer(_i2caddr, nullptr, 0, data, len) <= 0) data[0] = 0;
   }  // while
-}  // _sendCommand()
+  return (true);
+}  // _waitCTS()
 
 
-/// Set a property in the radio chip
-void SI47xx::_setProperty(uint16_t prop, uint16_t value) {
+/// Send a property to the radio chip.
+void SI47xx::_writeProperty(uint16_t prop, uint16_t value) {
   uint8_t cmdData[6] = {
     CMD_SET_PROPERTY,
     0,
@@ -882,8 +1202,9 @@ void SI47xx::_setProperty(uint16_t prop, uint16_t value) {
     static_cast<uint8_t>(value >> 8),
     static_cast<uint8_t>(value)
   };
-  _wireRead(_i2cPort, _i2caddr, cmdData, 6, &_status, 1);
-}  // _setProperty()
+  _transferCTS(cmdData, 6, &_status, 1);
+  _propWrites++;
+}  // _writeProperty()
 
 
 // ----- internal functions -----
@@ -18,6 +18,12 @@
 /// * 01.12.2019 created.
 /// * 17.09.2020 si4721 specific initialization moved into setBand()
 /// * 04.12.2020 more si47xx chips support.
+/// * 18.10.2026 RDS groups are passed with the block error levels.
+/// * 18.10.2026 RDS polling by the adaptive scheduler.
+/// * 18.10.2026 property shadow table, only changed properties are sent to the chip.
+/// * 18.10.2026 RDS transmit scheduler for RadioText, PTYN and clock time groups.
+/// * 18.10.2026 RadioText is only sent when changed.
+/// * 18.10.2026 waiting for CTS is limited by CTS_TIMEOUT.
 
 #ifndef SI47xx_h
 #define SI47xx_h
@@ -44,6 +50,21 @@ struct TX_STATUS {
   uint8_t noiseLevel;
 };
 
+// A structure for the RDS clock time (CT) to be transmitted
+struct RDS_TIME {
+  uint16_t year;   ///< UTC year, e.g. 2026
+  uint8_t month;   ///< UTC month 1..12
+  uint8_t day;     ///< UTC day 1..31
+  uint8_t hour;    ///< UTC hour 0..23
+  uint8_t minute;  ///< UTC minute 0..59
+  int8_t offset;   ///< local time offset in multiples of half hours
+};
+
+/// callback function for retrieving the current time for the RDS clock time groups.
+extern "C" {
+  typedef bool (*rdsTimeSourceFunction)(RDS_TIME *time);
+}
+
 // ----- library definition -----
 
 /// Library to control the SI47xx radio chip.
@@ -88,6 +109,7 @@ public:
   void seekDown(bool toNextSender = true);  // start seek mode downwards
 
   void attachReceiveRDS(receiveRDSFunction newFunction) override;  ///< Register a RDS processor function.
+  void attachReceiveRDSExt(receiveRDSExtFunction newFunction) override;  ///< Register a RDS processor function with error levels.
   void checkRDS();                                                 // read RDS data from the current station and process when data available.
 
   void getRadioInfo(RADIO_INFO *info);
@@ -95,14 +117,23 @@ public:
 
   // ----- debug Helpers send information to Serial port
 
-  void debugScan();    // Scan all frequencies and report a status
-  void debugStatus();  // Report Info about actual Station
+  void debugScan();        // Scan all frequencies and report a status
+  void debugStatus();      // Report Info about actual Station
+  void debugProperties();  // Report the properties in the shadow table
 
   // ----- transmit functions
 
   void beginRDS(uint16_t programID = 0xBEEF);
   void setRDSstation(char *s);
-  void setRDSbuffer(char *s);
+  void setRDSbuffer(char *s);  ///< Same as setRDSText().
+
+  void setRDSPTY(uint8_t pty);              ///< Set the program type of all transmitted groups.
+  void setRDSPTYN(const char *ptyn);        ///< Set the program type name (max. 8 chars) in 10A groups.
+  uint8_t setRDSText(const char *text);     ///< Set the RadioText (max. 64 chars) in 2A groups, returns the number of saved commands.
+  uint16_t getRDSCommandsSaved() { return (_rdsCommandsSaved); };  ///< Number of commands saved by unchanged RadioText.
+  void setRDSTime(RDS_TIME *time);          ///< Send a clock time 4A group once.
+  void attachRDSTimeSource(rdsTimeSourceFunction newFunction);  ///< Register a function for the clock time sent every minute.
+  void checkRDSTX();                        ///< Send the clock time when the minute has changed, call this in loop().
 
   uint8_t getTXPower();
   void setTXPower(uint8_t pwr);
@@ -132,6 +163,28 @@ private:
 
   uint8_t _txPower;
 
+  // ----- RDS transmit scheduler
+  // RadioText and PTYN groups are loaded into the circular buffer of the chip, clock time groups into the FIFO.
+
+  uint16_t _rdsPI = 0;         ///< program identification.
+  uint8_t _rdsPTY = 0;         ///< program type.
+  bool _rdsTextAB = false;     ///< A/B flag of the RadioText.
+  uint16_t _rdsCommandsSaved = 0;  ///< Number of commands not sent because the RadioText was unchanged.
+  char _rdsText[64 + 1];       ///< RadioText in the circular buffer.
+  char _rdsPTYN[8 + 1];        ///< program type name in the circular buffer.
+  rdsTimeSourceFunction _rdsTimeSource = nullptr;
+  unsigned long _rdsTimeCheck = 0;  ///< last check of the time source in millis.
+  uint8_t _rdsTimeMinute = 0xFF;    ///< the minute of the last clock time group.
+
+  // ----- property shadow table
+  // The values of the properties in the chip are kept in the shadow table.
+  // Changed values are marked as pending and sent by _flushProperties().
+
+  uint16_t _propValues[28];   ///< current values of the properties in the shadow table.
+  uint32_t _propPending = 0;  ///< bit mask of the properties that are not sent to the chip yet.
+  uint16_t _propWrites = 0;   ///< number of properties sent to the chip.
+  uint16_t _propSkips = 0;    ///< number of properties not sent because they are unchanged.
+
   /// structure used to read status information from the SI47xx radio chip.
   union {
     // use structured access
@@ -183,9 +236,39 @@ private:
   /// send a command
   void _sendCommand(int cnt, int cmd, ...);
 
-  /// set a property
+  /// set a property, unchanged values are skipped and changed values are queued.
   void _setProperty(uint16_t prop, uint16_t value);
 
+  /// send all pending properties to the chip.
+  void _flushProperties();
+
+  /// reset the shadow table to the default values of the chip after power up.
+  void _resetProperties();
+
+  /// send a property to the chip and wait until it is processed.
+  void _writeProperty(uint16_t prop, uint16_t value);
+
+  /// send a command and read the response until the CTS flag in the first byte is set or CTS_TIMEOUT is over.
+  /// \return false on a timeout.
+  bool _transferCTS(uint8_t *cmdData, int cmdLen, uint8_t *data, int len);
+
+  /// poll the response after a command until the CTS flag in the first byte is set.
+  /// \return false on a timeout.
+  bool _waitCTS(uint8_t *data, int len);
+
+  /// Build block B of a RDS group with the current program type.
+  uint16_t _rdsBlockB(uint8_t groupType, uint16_t bits);
+
+  /// Load one group into the circular buffer or the FIFO of the chip.
+  void _loadRDSGroup(uint8_t flags, uint16_t blockB, uint16_t blockC, uint16_t blockD);
+
+  /// Load all RadioText and PTYN groups into the circular buffer in one batch.
+  void _loadRDSBuffer();
+
+  /// Build the RadioText as transmitted: ended by CR and padded to full segments.
+  /// @return number of segments.
+  uint8_t _rdsTextSegments(const char *text, char *buffer);
+
   /// read the interrupt status.
   uint8_t _readStatus();
 
@@ -194,6 +277,9 @@ private:
 
   void _seek(bool seekUp = true);
   void _waitEnd();
+
+  /// enable RDS receiving in the chip.
+  void _enableRDS();
 };
 
 #endif
@@ -36,6 +36,11 @@
 #define QUARTZ 32768
 #define FILTER 225000
 
+#define TEA5767_TUNE_SETTLE 30     // msec. for the PLL and the level ADC to settle after tuning to a frequency
+#define TEA5767_SEEK_TIMEOUT 2000  // max. msec. for a seek including the wrap around at the band limit
+
+#define TEA5767_IMAGE_OFFSET 45  // 450 kHz offset to the image frequencies measured for injection side selection.
+
 // Define the registers
 
 #define REG_1 0x00
@@ -49,7 +54,9 @@
 #define REG_3 0x02
 #define REG_3_MS   0x08
 #define REG_3_SSL  0x60
+#define REG_3_SSL_MID 0x40  // search stop level: ADC output = 7
 #define REG_3_SUD  0x80
+#define REG_3_HLSI 0x10  // high side LO injection
 
 #define REG_4 0x03
 #define REG_4_SMUTE 0x08
@@ -62,6 +69,10 @@
 #define REG_5_DTC     0x40
 
 
+#define STAT_1 0x00
+#define STAT_1_RF   0x80  // ready flag: tuning or search is complete
+#define STAT_1_BLF  0x40  // band limit flag: search has reached the band limit
+
 #define STAT_3 0x02
 #define STAT_3_STEREO 0x80
 
@@ -76,6 +87,7 @@
 
 // initialize the extra variables in SI4703
 TEA5767::TEA5767() {
+  _i2caddr = TEA5767_ADR;  // standard address of chip
   _maxVolume = 1;
 }
 
@@ -84,19 +96,25 @@ bool TEA5767::init() {
   bool result = false; // no chip found yet.
   DEBUG_FUNC0("init");
 
-  RADIO::init();  // will create reset impulse
+  RADIO::init();  // will create reset impulse, init() may be called without initWire()
 
   registers[0] = 0x00;
   registers[1] = 0x00;
   registers[2] = 0xB0;
   registers[REG_4] = REG_4_XTAL | REG_4_SMUTE;
 
+  memset(_injectionFreq, 0, sizeof(_injectionFreq));
+  _injectionHigh = 0;
+  _injectionNext = 0;
+
 #ifdef IN_EUROPE
   registers[REG_5] = 0; // 50 ms Europe setup
 #else
   registers[REG_5] = REG_5_DTC; // 75 ms Europe setup
 #endif
-  Wire.begin();
+
+  _bus->begin();
+  result = RADIO::_wireExists(_bus, _i2caddr);
 
   return(result);
 } // init()
@@ -193,14 +211,39 @@ RADIO_FREQ TEA5767::getFrequency() {
   _readRegisters();
 
   unsigned long frequencyW = ((status[REG_1] & REG_1_PLL) << 8) | status[REG_2];
-  frequencyW = ((frequencyW * QUARTZ / 4) - FILTER) / 10000;
+  frequencyW = frequencyW * QUARTZ / 4;
+  if (registers[REG_3] & REG_3_HLSI) {
+    frequencyW -= FILTER;
+  } else {
+    frequencyW += FILTER;
+  }
+  frequencyW = (frequencyW + 5000) / 10000;
 
   return ((RADIO_FREQ)frequencyW);
 }  // getFrequency
 
 
+/// Set the PLL registers for the frequency without changing the other bits in the registers.
+/// The PLL value depends on the high or low side injection.
+void TEA5767::_setPLL(RADIO_FREQ f) {
+  unsigned long fLO = f * 10000L;
+  if (registers[REG_3] & REG_3_HLSI) {
+    fLO += FILTER;
+  } else {
+    fLO -= FILTER;
+  }
+  unsigned int frequencyB = 4 * fLO / QUARTZ;
+
+  registers[REG_1] = (registers[REG_1] & ~REG_1_PLL) | ((frequencyB >> 8) & REG_1_PLL);
+  registers[REG_2] = frequencyB & 0XFF;
+} // _setPLL()
+
+
 /**
 * @brief Change the frequency in the chip.
+* The function returns after the settle time of the PLL.
+* When a new frequency is requested during the injection probe the tune is skipped
+* as checkRequests() tunes to the new frequency next.
 * @param newF
 * @return void
 */
@@ -208,16 +251,72 @@ void TEA5767::setFrequency(RADIO_FREQ newF) {
   DEBUG_FUNC1("setFrequency", newF);
   _freq = newF;
 
-  unsigned int frequencyB = 4 * (newF * 10000L + FILTER) / QUARTZ;
-  Serial.print('*'); Serial.println(frequencyB);
-
-  registers[0] = frequencyB >> 8;
-  registers[1] = frequencyB & 0XFF;
+  registers[REG_1] &= ~REG_1_SM;
+  if (!_selectInjection(newF)) return;
+  _setPLL(newF);
   _saveRegisters();
-  delay(100);
+  _waitTune();
 } // setFrequency()
 
 
+/// Tune to a frequency and return the level from the ADC.
+uint8_t TEA5767::_probeLevel(RADIO_FREQ f) {
+  _setPLL(f);
+  _saveRegisters();
+  _waitTune();
+  return ((status[STAT_4] & STAT_4_ADC) >> 4);
+} // _probeLevel()
+
+
+/// Select the injection side with less interference by an image frequency.
+/// As described in the application note the levels at f + 450 kHz and f - 450 kHz are measured
+/// and high side injection is used when the level at f + 450 kHz is lower.
+/// The audio is muted during the probe.
+/// The probe costs 2 tunes so the result is kept for the last TEA5767_INJECTION_CACHE frequencies
+/// and only new frequencies are probed.
+/// \return false when the probe was stopped by a new frequency request, the injection side is unchanged then.
+bool TEA5767::_selectInjection(RADIO_FREQ f) {
+  for (uint8_t n = 0; n < TEA5767_INJECTION_CACHE; n++) {
+    if (_injectionFreq[n] == f) {
+      if (_injectionHigh & (1 << n)) registers[REG_3] |= REG_3_HLSI;
+      else registers[REG_3] &= ~REG_3_HLSI;
+      return (true);
+    }
+  }  // for
+
+  uint8_t mute = registers[REG_1] & REG_1_MUTE;
+  uint8_t hlsi = registers[REG_3] & REG_3_HLSI;
+  uint8_t levelHigh, levelLow = 0;
+
+  registers[REG_1] |= REG_1_MUTE;
+  registers[REG_3] |= REG_3_HLSI;
+  levelHigh = _probeLevel(f + TEA5767_IMAGE_OFFSET);
+  if (!_tuneAbort()) {
+    registers[REG_3] &= ~REG_3_HLSI;
+    levelLow = _probeLevel(f - TEA5767_IMAGE_OFFSET);
+  }
+
+  registers[REG_1] = (registers[REG_1] & ~REG_1_MUTE) | mute;
+  if (_tuneAbort()) {
+    // the levels are not complete.
+    registers[REG_3] = (registers[REG_3] & ~REG_3_HLSI) | hlsi;
+    DEBUG_STR("_selectInjection: stopped");
+    return (false);
+  }
+
+  uint8_t n = _injectionNext;
+  _injectionFreq[n] = f;
+  _injectionHigh &= ~(1 << n);
+  if (levelHigh < levelLow) {
+    registers[REG_3] |= REG_3_HLSI;
+    _injectionHigh |= (1 << n);
+  }
+  _injectionNext = (n + 1) % TEA5767_INJECTION_CACHE;
+  DEBUG_FUNC2("_selectInjection", levelHigh, levelLow);
+  return (true);
+} // _selectInjection()
+
+
 /// Start seek mode upwards.
 void TEA5767::seekUp(bool toNextSender) {
   DEBUG_FUNC0("seekUp");
@@ -237,13 +336,8 @@ void TEA5767::seekDown(bool toNextSender) {
 /// Load all status registers from to the chip
 void TEA5767::_readRegisters()
 {
-  Wire.requestFrom(TEA5767_ADR, 5); // We want to read all the 5 registers.
-
-  if (Wire.available()) {
-    for (uint8_t n = 0; n < 5; n++) {
-      status[n] = Wire.read();
-    } // for
-  } // if
+  // We want to read all the 5 registers.
+  RADIO::_wireReadFrom(_bus, _i2caddr, status, sizeof(status));
 } // _readRegisters
 
 
@@ -251,17 +345,7 @@ void TEA5767::_readRegisters()
 // using the sequential write access mode.
 void TEA5767::_saveRegisters()
 {
-  Wire.beginTransmission(TEA5767_ADR);
-  for (uint8_t n = 0; n < sizeof(registers); n++) {
-    Wire.write(registers[n]);
-  } // for
-
-  byte ack = Wire.endTransmission();
-  if (ack != 0) { //We have a problem!
-    Serial.print("Write Fail:"); //No ACK!
-    Serial.println(ack, DEC); //I2C error: 0 = success, 1 = data too long, 2 = rx NACK on address, 3 = rx NACK on data, 4 = other error
-  } // if
-
+  RADIO::_wireWriteTo(_bus, _i2caddr, registers, sizeof(registers));
 } // _saveRegisters
 
 
@@ -294,17 +378,85 @@ void TEA5767::debugStatus()
 } // debugStatus
 
 
-/// Seeks out the next available station
+/// Seeks out the next available station using the search mode of the chip.
+/// The search starts one step beside the current frequency and stops at a station
+/// with a level above the search stop level.
+/// When the band limit is reached the search continues once from the other end of the band.
+/// Both parts together are limited by TEA5767_SEEK_TIMEOUT.
 void TEA5767::_seek(bool seekUp) {
   DEBUG_FUNC0("_seek");
-  (void)seekUp;
+  unsigned long start = millis();
+  RADIO_FREQ f = getFrequency();
+
+  if (seekUp) {
+    f = (f + _freqSteps <= _freqHigh) ? f + _freqSteps : _freqLow;
+  } else {
+    f = (f - _freqSteps >= _freqLow) ? f - _freqSteps : _freqHigh;
+  }
+
+  registers[REG_3] &= ~(REG_3_SUD | REG_3_SSL);
+  registers[REG_3] |= REG_3_SSL_MID;
+  if (seekUp) registers[REG_3] |= REG_3_SUD;
+
+  for (uint8_t round = 0; round < 2; round++) {
+    unsigned long used = millis() - start;
+    if (used >= TEA5767_SEEK_TIMEOUT) break;
+
+    // start the search mode at the frequency
+    registers[REG_1] |= REG_1_SM;
+    _setPLL(f);
+    _saveRegisters();
+    _waitEnd(TEA5767_SEEK_TIMEOUT - used);
+
+    if (_tuneAbort()) {
+      // a new frequency is requested, don't tune to the interim frequency of the search.
+      DEBUG_STR("_seek: stopped");
+      return;
+    }
+    if (!(status[STAT_1] & STAT_1_BLF)) break;
+    // band limit reached: continue from the other end of the band.
+    f = seekUp ? _freqLow : _freqHigh;
+  } // for
+
+  // leave the search mode and stay on the found frequency using the better injection side.
+  setFrequency(getFrequency());
 } // _seek
 
 
-/// wait until the current seek and tune operation is over.
-void TEA5767::_waitEnd() {
-  DEBUG_FUNC0("_waitEnd");
+/// wait the settle time after tuning to a frequency in preset mode,
+/// the ready flag is only defined for the search mode.
+/// The status registers contain the state after the wait.
+/// Waiting is stopped when a new frequency is requested.
+/// \return false when the wait was stopped.
+bool TEA5767::_waitTune() {
+  unsigned long start = millis();
+
+  do {
+    if (_tuneAbort()) return (false);
+    delay(1);
+  } while (millis() - start < TEA5767_TUNE_SETTLE);
 
+  _readRegisters();
+  return (true);
+} // _waitTune()
+
+
+/// wait until the current search is over by polling the ready flag.
+/// The status registers contain the final state.
+/// Waiting is stopped when a new frequency is requested as the chip accepts a new PLL value at any time.
+/// \return true when the ready flag was set before the timeout.
+bool TEA5767::_waitEnd(unsigned long timeout) {
+  unsigned long start = millis();
+
+  do {
+    _readRegisters();
+    if (status[STAT_1] & STAT_1_RF) return (true);
+    if (_tuneAbort()) return (false);
+    delay(1);
+  } while (millis() - start < timeout);
+
+  DEBUG_STR("_waitEnd: timeout");
+  return (false);
 } // _waitEnd()
 
 
@@ -15,6 +15,11 @@
 /// --------
 /// * 05.08.2014 created.
 /// * 27.05.2015 working-
+/// * 18.10.2026 seek using the search mode of the chip, tuning by polling the ready flag.
+/// * 18.10.2026 using the configurable i2c port and automatic high/low side injection.
+/// * 18.10.2026 waiting for the ready flag is stopped by a new frequency request.
+/// * 18.10.2026 the injection side is probed once per frequency and kept in a small cache.
+/// * 18.10.2026 tuning waits a fixed settle time, the ready flag is only used in search mode.
 
 
 #ifndef TEA5767_h
@@ -27,6 +32,8 @@
 
 // ----- library definition -----
 
+#define TEA5767_INJECTION_CACHE 8  ///< number of frequencies with a known injection side, max. 8.
+
 
 /// Library to control the TEA5767 radio chip.
 class TEA5767 : public RADIO {
@@ -89,8 +96,18 @@ class TEA5767 : public RADIO {
   void     _write16(uint16_t val);        // Write 16 Bit Value on I2C-Bus
   uint16_t _read16(void);
   
+  void _setPLL(RADIO_FREQ f);  // set the PLL registers for the frequency.
+
+  uint8_t _probeLevel(RADIO_FREQ f);    // tune to a frequency and return the level.
+  bool _selectInjection(RADIO_FREQ f);  // select high or low side injection for a frequency.
+
+  RADIO_FREQ _injectionFreq[TEA5767_INJECTION_CACHE];  ///< frequencies with a probed injection side, 0 = unused.
+  uint8_t _injectionHigh;  ///< bit n is set for high side injection on _injectionFreq[n].
+  uint8_t _injectionNext;  ///< the cache entry that is replaced next.
+
   void _seek(bool seekUp = true);
-  void _waitEnd();
+  bool _waitTune();
+  bool _waitEnd(unsigned long timeout);
 };
 
 #endif
@@ -19,6 +19,16 @@
 
 // no chip-registers without a chip.
 
+// ----- RDS poll scheduler timing in micros -----
+
+#define RDS_GROUPTIME 87579UL  // 104 bits at 1187.5 bit/sec
+#define RDS_WINDOW 3000UL      // poll this time before and after the expected arrival of a group
+#define RDS_RETRY 2500UL       // poll interval within the window, must be less than RDS_WINDOW
+#define RDS_MAXMISS 6          // number of missing groups until tracking is given up
+#define RDS_FASTPROBE 40000UL  // probe interval without tracking, less than a group time to not loose a group
+#define RDS_SLOWPROBE 250000UL // probe interval when there is no RDS at all
+#define RDS_ACQUIRE 3000000UL  // time for fast probing after tuning or loosing the tracking
+
 // ----- implement
 
 /// Setup the radio object and initialize private variables to 0.
@@ -38,22 +48,43 @@ void RADIO::setup(int feature, int value) {
     _fmSpacing = value;
   } else if ((feature == RADIO_DEEMPHASIS) && (value > 0)) {
     _deEmphasis = value;
+  } else if (feature == RADIO_RDSPOLL) {
+    _rdsPollMode = value;
   }
 
 }  // setup()
 
 
-/// The RADIO class doesn't implement a concrete chip so nothing has to be initialized.
+#if defined(ARDUINO)
+/// Use the Wire port through the RadioWireBus adapter.
 bool RADIO::initWire(TwoWire &port) {
   DEBUG_FUNC0("RADIO::initWire");
 
-  _i2cPort = &port;
-  return (this->init());
+  _wireBus.setPort(&port);
+  return (initBus(_wireBus));
 }  // initWire()
+#endif
+
+
+/// Use any bus implementation and initialize the chip.
+bool RADIO::initBus(RadioBus &bus) {
+  DEBUG_FUNC0("RADIO::initBus");
+
+  _bus = &bus;
+  return (this->init());
+}  // initBus()
 
 
 /// The RADIO class doesn't implement a concrete chip so nothing has to be initialized.
 bool RADIO::init() {
+#if defined(ARDUINO)
+  // init() may be called without initWire()
+  if (!_bus) {
+    _wireBus.setPort(&Wire);
+    _bus = &_wireBus;
+  }
+#endif
+
   if (_resetPin >= 0) {
     // create a reset impulse
     pinMode(_resetPin, OUTPUT);
@@ -243,8 +274,14 @@ void RADIO::checkRDS() { /* no chip : nothing to check */
 /// Send a 0.0.0.0 to the RDS receiver if there is any attached.
 /// This is to point out that there is a new situation and all existing data should be invalid from now on.
 void RADIO::clearRDS() {
+  // restart fast probing for RDS groups
+  _rdsTracking = false;
+  _rdsProbeStart = _rdsNextPoll = micros();
+
   if (_sendRDS)
     _sendRDS(0, 0, 0, 0);
+  if (_sendRDSExt)
+    _sendRDSExt(0, 0, 0, 0, 0);
 }  // clearRDS()
 
 
@@ -255,6 +292,125 @@ void RADIO::attachReceiveRDS(receiveRDSFunction newFunction) {
 }  // attachReceiveRDS()
 
 
+// remember the extended RDS function
+void RADIO::attachReceiveRDSExt(receiveRDSExtFunction newFunction) {
+  _sendRDSExt = newFunction;
+}  // attachReceiveRDSExt()
+
+
+// check if polling the chip for RDS data is due.
+bool RADIO::_rdsPollDue() {
+  if (_rdsPollMode == RADIO_RDSPOLL_ALWAYS) return (true);
+  return ((long)(micros() - _rdsNextPoll) >= 0);
+}  // _rdsPollDue()
+
+
+// schedule the next poll for RDS data.
+void RADIO::_rdsPollDone(bool received) {
+  unsigned long now = micros();
+
+  if (received) {
+    // the next group is expected one group time later.
+    _rdsTracking = true;
+    _rdsMisses = 0;
+    _rdsLastGroup = now;
+    _rdsNextPoll = now + RDS_GROUPTIME - RDS_WINDOW;
+
+  } else if (_rdsTracking) {
+    unsigned long expected = _rdsLastGroup + (_rdsMisses + 1) * RDS_GROUPTIME;
+
+    if ((long)(now - expected) < (long)RDS_WINDOW) {
+      // still within the window of the expected group.
+      _rdsNextPoll = now + RDS_RETRY;
+
+    } else if (++_rdsMisses < RDS_MAXMISS) {
+      // group was lost, wait for the next one.
+      _rdsNextPoll = expected + RDS_GROUPTIME - RDS_WINDOW;
+
+    } else {
+      // no more RDS, start fast probing.
+      _rdsTracking = false;
+      _rdsProbeStart = now;
+      _rdsNextPoll = now + RDS_FASTPROBE;
+    }
+
+  } else if (now - _rdsProbeStart < RDS_ACQUIRE) {
+    _rdsNextPoll = now + RDS_FASTPROBE;
+
+  } else {
+    _rdsNextPoll = now + RDS_SLOWPROBE;
+  }  // if
+}  // _rdsPollDone()
+
+
+// ----- Requests -----
+
+/// Store the frequency for checkRequests().
+/// This function is short and can be called from an interrupt.
+void RADIO::requestFrequency(RADIO_FREQ newF) {
+  if (_reqFreqPending) _reqDropped++;
+  _reqFreq = newF;
+  _reqFreqPending = true;
+}  // requestFrequency()
+
+
+/// Store the volume for checkRequests().
+/// This function is short and can be called from an interrupt.
+void RADIO::requestVolume(int8_t newVolume) {
+  if (_reqVolumePending) _reqDropped++;
+  _reqVolume = newVolume;
+  _reqVolumePending = true;
+}  // requestVolume()
+
+
+/// Apply the latest requested frequency and volume.
+/// Requests given while a tune is running are applied by the next call.
+bool RADIO::checkRequests() {
+  bool applied = false;
+
+  // not when called again while the chip is busy, e.g. from a callback.
+  if (_reqBusy) return (false);
+  _reqBusy = true;
+
+  if (_reqFreqPending) {
+    noInterrupts();
+    RADIO_FREQ f = _reqFreq;
+    _reqFreqPending = false;
+    interrupts();
+    setFrequency(f);
+    applied = true;
+  }  // if
+
+  if (_reqVolumePending) {
+    noInterrupts();
+    int8_t v = _reqVolume;
+    _reqVolumePending = false;
+    interrupts();
+    setVolume(v);
+    applied = true;
+  }  // if
+
+  _reqBusy = false;
+  return (applied);
+}  // checkRequests()
+
+
+// send a group to the extended RDS function and valid data to the simple RDS function.
+void RADIO::_receiveRDS(uint16_t block1, uint16_t block2, uint16_t block3, uint16_t block4, uint8_t errors) {
+  if (_sendRDSExt)
+    _sendRDSExt(block1, block2, block3, block4, errors);
+
+  if (_sendRDS) {
+    bool good = true;
+    for (uint8_t n = 0; n < 4; n++) {
+      if (RDS_BLOCKERR(errors, n) == RDS_ERRLEVEL_UNCORRECT) good = false;
+    }
+    if (good)
+      _sendRDS(block1, block2, block3, block4);
+  }  // if
+}  // _receiveRDS()
+
+
 // format the current frequency for display and printing
 void RADIO::formatFrequency(char *s, uint8_t length) {
   RADIO_BAND b = getBand();
@@ -346,6 +502,51 @@ void RADIO::int16_to_s(char *s, uint16_t val) {
 }  // int16_to_s()
 
 
+// ===== RadioWireBus =====
+
+#if defined(ARDUINO)
+bool RadioWireBus::begin() {
+  _port->begin();
+  return (true);
+}  // begin()
+
+
+int RadioWireBus::transfer(uint8_t address, const uint8_t *cmdData, int cmdLen, uint8_t *data, int len) {
+  return (_transfer(address, cmdData, cmdLen, data, len, true));
+}  // transfer()
+
+
+int RadioWireBus::transferRestart(uint8_t address, const uint8_t *cmdData, int cmdLen, uint8_t *data, int len) {
+  return (_transfer(address, cmdData, cmdLen, data, len, false));
+}  // transferRestart()
+
+
+// write and read, the write part ends with a stop or a repeated start when data is read.
+int RadioWireBus::_transfer(uint8_t address, const uint8_t *cmdData, int cmdLen, uint8_t *data, int len, bool sendStop) {
+  int received = 0;
+  transfers++;
+
+  if ((cmdLen > 0) || (len == 0)) {
+    _port->beginTransmission(address);
+    for (int i = 0; i < cmdLen; i++) {
+      _port->write(cmdData[i]);
+    }
+    if (_port->endTransmission(sendStop || (len == 0)) != 0) return (-1);
+    bytes += cmdLen;
+  }
+
+  if ((data) && (len > 0)) {
+    received = _port->requestFrom((int)address, len);
+    for (int n = 0; n < received; n++) {
+      data[n] = _port->read();
+    }
+    bytes += received;
+  }
+  return (received);
+}  // _transfer()
+#endif
+
+
 // ===== Wire Utilities =====
 
 bool RADIO::_wireDebugFlag = false;
@@ -360,51 +561,56 @@ void RADIO::_wireDebug(bool enable) {
 }  // _wireDebug()
 
 
-bool RADIO::_wireExists(TwoWire *port, int address) {
-  port->beginTransmission(address);
-  uint8_t err = port->endTransmission();
+// write bytes as hex values to Serial
+static void _wireDebugData(const uint8_t *data, int len) {
+  for (int i = 0; i < len; i++) {
+    if (data[i] < 16) Serial.print('0');
+    Serial.print(data[i], 16);
+    Serial.print(' ');
+  }  // for
+}  // _wireDebugData()
+
+
+bool RADIO::_wireExists(RadioBus *bus, int address) {
+  int res = bus->transfer(address, nullptr, 0, nullptr, 0);
   if (_wireDebugEnabled) {
     Serial.print("_wireExists(");
     Serial.print(address);
-    Serial.print("): err=");
-    Serial.println(err);
+    Serial.print("): res=");
+    Serial.println(res);
   }
-  return (err == 0);
+  return (res == 0);
+}
+
+#if defined(ARDUINO)
+bool RADIO::_wireExists(TwoWire *port, int address) {
+  RadioWireBus bus;
+  bus.setPort(port);
+  return (_wireExists(&bus, address));
 }
+#endif
 
 // a i2c transmission in one call
-void RADIO::_wireWriteTo(TwoWire *port, int address, uint8_t *cmdData, int cmdLen) {
+void RADIO::_wireWriteTo(RadioBus *bus, int address, uint8_t *cmdData, int cmdLen) {
   if (cmdData && cmdLen > 0) {
     // send out command sequence
-    port->beginTransmission(address);
     if (_wireDebugFlag) {
       Serial.print("--write(0x");
       Serial.print(address, 16);
       Serial.print("): ");
+      _wireDebugData(cmdData, cmdLen);
     }
-
-    for (int i = 0; i < cmdLen; i++) {
-      uint8_t d = cmdData[i];
-      port->write(d);
-      if (_wireDebugFlag) {
-        // write a hex value to Serial
-        if (d < 16) Serial.print('0');
-        Serial.print(d, 16);
-        Serial.print(' ');
-      }  // if
-    }    // for
-
-    port->endTransmission();
+    bus->transfer(address, cmdData, cmdLen, nullptr, 0);
   }  // if
 }  // _wireWriteTo
 
 
 // a i2c request in one call
-uint8_t RADIO::_wireReadFrom(TwoWire *port, int address, uint8_t *data, int len) {
-  uint8_t received = 0;
+uint8_t RADIO::_wireReadFrom(RadioBus *bus, int address, uint8_t *data, int len) {
+  int received = 0;
   if (data && len > 0) {
-    while (!received) {
-      received = port->requestFrom(address, len);
+    while (received <= 0) {
+      received = bus->transfer(address, nullptr, 0, data, len);
       if (_wireDebugFlag) {
         Serial.print('[');
         Serial.print(received);
@@ -412,34 +618,24 @@ uint8_t RADIO::_wireReadFrom(TwoWire *port, int address, uint8_t *data, int len)
       }
     }
 
-    uint8_t *d = data;
-    for (int n = 0; n < received; n++) {
-      *d = port->read();
-      if (_wireDebugFlag) {
-        // write a hex value to Serial
-        if (*d < 16) Serial.print('0');
-        Serial.print(*d, 16);
-        Serial.print(' ');
-      }
-      d++;
+    if (_wireDebugFlag) {
+      _wireDebugData(data, received);
     }
   }
   return (received);
 }  // _wireReadFrom
 
 
-// write a 16 bit value in High-Low order to the Wire.
-void RADIO::_write16HL(TwoWire *port, uint16_t val) {
-  port->write(val >> 8);
-  port->write(val & 0xFF);
+// write a 16 bit value in High-Low order to a buffer.
+void RADIO::_write16HL(uint8_t *data, uint16_t val) {
+  data[0] = val >> 8;
+  data[1] = val & 0xFF;
 }  // _write16HL
 
 
-// read a 16 bit value in High-Low order from the Wire.
-uint16_t RADIO::_read16HL(TwoWire *port) {
-  uint8_t hiByte = port->read();
-  uint8_t loByte = port->read();
-  return ((hiByte << 8) + loByte);
+// read a 16 bit value in High-Low order from a buffer.
+uint16_t RADIO::_read16HL(const uint8_t *data) {
+  return ((data[0] << 8) + data[1]);
 }  // _read16HL
 
 
@@ -453,8 +649,8 @@ uint16_t RADIO::_read16HL(TwoWire *port) {
  * @param len length of data buffer.
  * @return number of register values received.
  */
-int RADIO::_wireRead(TwoWire *port, int address, uint8_t reg, uint8_t *data, int len) {
-  return (_wireRead(port, address, &reg, 1, data, len));
+int RADIO::_wireRead(RadioBus *bus, int address, uint8_t reg, uint8_t *data, int len) {
+  return (_wireRead(bus, address, &reg, 1, data, len));
 }  // _wireRead()
 
 
@@ -469,20 +665,33 @@ int RADIO::_wireRead(TwoWire *port, int address, uint8_t reg, uint8_t *data, int
  * @param len length of data buffer.
  * @return number of register values received.
  */
-int RADIO::_wireRead(TwoWire *port, int address, uint8_t *cmdData, int cmdLen, uint8_t *data, int len) {
+int RADIO::_wireRead(RadioBus *bus, int address, uint8_t *cmdData, int cmdLen, uint8_t *data, int len) {
   int received = 0;
 
-  RADIO::_wireWriteTo(port, address, cmdData, cmdLen);
+  if (!data) {
+    RADIO::_wireWriteTo(bus, address, cmdData, cmdLen);
+
+  } else {
+    if (RADIO::_wireDebugFlag) {
+      Serial.print("--write(0x");
+      Serial.print(address, 16);
+      Serial.print("): ");
+      _wireDebugData(cmdData, cmdLen);
+      Serial.print(" -> ");
+    }
+
+    // write the command and read the answer in one transfer.
+    received = bus->transfer(address, cmdData, cmdLen, data, len);
+    if (RADIO::_wireDebugFlag) {
+      _wireDebugData(data, received);
+    }
 
-  // read requested data (when buffer is available)
-  if (data) {
-    while (received == 0) {
+    // read again until the command is done.
+    while ((received <= 0) || (!(*data & 0x80))) {
       if (RADIO::_wireDebugFlag) {
         Serial.print(" -> ");
       }
-      received = RADIO::_wireReadFrom(port, address, data, len);
-      if (!(*data & 0x80))
-        received = 0;
+      received = RADIO::_wireReadFrom(bus, address, data, len);
     }
 
     if (RADIO::_wireDebugFlag) {
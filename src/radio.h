@@ -27,6 +27,10 @@
  * * 29.04.2015 clear RDS function, need to clear RDS info after tuning.
  * * 17.09.2020 Wire Util functions added.
  * * 06.12.2020 I2C Wire and Reset initialization centralized.
+ * * 18.10.2026 extended RDS callback with error levels per block.
+ * * 18.10.2026 adaptive RDS poll scheduler.
+ * * 18.10.2026 frequency and volume requests, only the latest one is applied.
+ * * 18.10.2026 i2c bus abstraction RadioBus with an adapter for the Wire library.
  *
  * TODO:
  */
@@ -147,8 +151,26 @@
 /// callback function for passing RDS data.
 extern "C" {
   typedef void (*receiveRDSFunction)(uint16_t block1, uint16_t block2, uint16_t block3, uint16_t block4);
+
+  /// callback function for passing RDS data together with the error levels of the 4 blocks.
+  typedef void (*receiveRDSExtFunction)(uint16_t block1, uint16_t block2, uint16_t block3, uint16_t block4, uint8_t errors);
 }
 
+// ----- RDS block error levels -----
+// The errors parameter of the extended RDS callback packs a 2 bit error level for each block:
+// block A in bits 7:6, block B in bits 5:4, block C in bits 3:2 and block D in bits 1:0.
+
+#define RDS_ERRLEVEL_NONE 0       ///< no errors in the block.
+#define RDS_ERRLEVEL_LOW 1        ///< 1-2 bit errors corrected.
+#define RDS_ERRLEVEL_HIGH 2       ///< 3-5 bit errors corrected.
+#define RDS_ERRLEVEL_UNCORRECT 3  ///< uncorrectable, the block must not be used.
+
+/// Extract the error level of block n (0 = A ... 3 = D) from the packed errors.
+#define RDS_BLOCKERR(errors, n) (((errors) >> (6 - 2 * (n))) & 0x03)
+
+/// Pack the error levels of the 4 blocks into one byte.
+#define RDS_PACKERRORS(errA, errB, errC, errD) ((uint8_t)(((errA) << 6) | ((errB) << 4) | ((errC) << 2) | (errD)))
+
 
 // ----- type definitions -----
 
@@ -191,6 +213,61 @@ struct AUDIO_INFO {
   bool bassBoost;
 };
 
+// ----- i2c bus abstraction -----
+
+/// Interface to the i2c bus used by the radio chip libraries.
+/// Writing and reading data is done by one transfer so a bus implementation can send it
+/// as one combined message with a repeated start, e.g. with a single system call on Linux.
+class RadioBus {
+public:
+  virtual ~RadioBus() {};
+
+  /// Start using the bus.
+  virtual bool begin() { return (true); };
+
+  /**
+   * Write and then read data in one transfer.
+   * @param address i2c address of the device.
+   * @param cmdData data to be sent. If cmdLen is 0 nothing is sent.
+   * @param cmdLen length of cmdData.
+   * @param data buffer for the received data. If len is 0 nothing is requested.
+   * @param len length of the data buffer.
+   * @return number of received bytes or -1 when the device didn't answer.
+   */
+  virtual int transfer(uint8_t address, const uint8_t *cmdData, int cmdLen, uint8_t *data, int len) = 0;
+
+  /// Write and then read data with a repeated start instead of a stop between both parts.
+  /// Buses that always use a repeated start don't need to override this.
+  virtual int transferRestart(uint8_t address, const uint8_t *cmdData, int cmdLen, uint8_t *data, int len) {
+    return (transfer(address, cmdData, cmdLen, data, len));
+  };
+
+  /// Number of transfers on the bus, can be reset for measuring.
+  uint32_t transfers = 0;
+
+  /// Number of bytes written and read on the bus, can be reset for measuring.
+  uint32_t bytes = 0;
+};
+
+
+#if defined(ARDUINO)
+/// Adapter to use the i2c bus of the Wire library as a RadioBus.
+/// A stop is sent between writing and reading as some chips only start processing a command after the stop,
+/// transferRestart() uses a repeated start.
+class RadioWireBus : public RadioBus {
+public:
+  void setPort(TwoWire *port) { _port = port; };  ///< Set the Wire port to be used.
+  bool begin() override;
+  int transfer(uint8_t address, const uint8_t *cmdData, int cmdLen, uint8_t *data, int len) override;
+  int transferRestart(uint8_t address, const uint8_t *cmdData, int cmdLen, uint8_t *data, int len) override;
+
+private:
+  TwoWire *_port = nullptr;
+  int _transfer(uint8_t address, const uint8_t *cmdData, int cmdLen, uint8_t *data, int len, bool sendStop);
+};
+#endif
+
+
 // ----- common RADIO class definition -----
 
 // setup() features and defined values
@@ -216,6 +293,11 @@ struct AUDIO_INFO {
 #define RADIO_DEEMPHASIS_50 50 // 50µs typically used in Europe, Australia, Japan
 #define RADIO_DEEMPHASIS_75 75 // 75µs typically used in USA
 
+// Polling the chip for RDS data
+#define RADIO_RDSPOLL 0x07
+#define RADIO_RDSPOLL_ALWAYS 0    // check the chip on every checkRDS() call
+#define RADIO_RDSPOLL_ADAPTIVE 1  // check the chip just after the next RDS group is expected = default
+
 /// Library to control radio chips in general. This library acts as a base library for the chip specific implementations.
 class RADIO {
 
@@ -226,7 +308,11 @@ public:
 
   virtual void setup(int feature, int value);  ///< configure board/hardware specific features before init().
   virtual bool init();                         ///< initialize library and the chip.
+#if defined(ARDUINO)
   virtual bool initWire(TwoWire &port);        // init with I2C bus
+#endif
+  virtual bool initBus(RadioBus &bus);         ///< init with any i2c bus implementation.
+  RadioBus *getBus() { return (_bus); };       ///< the bus in use, e.g. for reading the counters.
   virtual void term();                         ///< terminate all radio functions.
 
   // ----- Audio features -----
@@ -264,6 +350,19 @@ public:
   virtual void setMono(bool switchOn);  ///< Control the mono mode of the radio chip.
   virtual bool getMono();               ///< Retrieve the current mono mode setting.
 
+  // ----- Requests -----
+  // Frequency and volume changes can be requested at any rate, e.g. by a rotary encoder, also from an interrupt.
+  // Only the latest request is applied by checkRequests() when the chip is not busy.
+
+  void requestFrequency(RADIO_FREQ newF);  ///< Request a new frequency, replaces a pending frequency request.
+  void requestVolume(int8_t newVolume);    ///< Request a new volume, replaces a pending volume request.
+
+  /// Apply the latest requested frequency and volume, call this in loop().
+  /// @return true when a request was applied.
+  virtual bool checkRequests();
+
+  uint16_t getRequestsDropped() { return (_reqDropped); };  ///< Number of requests replaced by a later one.
+
   // ----- combined status functions -----
 
   virtual void getRadioInfo(RADIO_INFO *info);  ///< Retrieve some information about the current radio function of the chip.
@@ -273,6 +372,11 @@ public:
   // ----- Supporting RDS for FM bands -----
 
   virtual void attachReceiveRDS(receiveRDSFunction newFunction);  ///< Register a RDS processor function.
+
+  /// Register a RDS processor function that also gets the error levels of the blocks.
+  /// All groups received by the chip are passed including partially correct ones.
+  virtual void attachReceiveRDSExt(receiveRDSExtFunction newFunction);
+
   virtual void checkRDS();                                        ///< Check if RDS Data is available and good.
   virtual void clearRDS();                                        ///< Clear RDS data in the attached RDS Receiver by sending 0,0,0,0.
 
@@ -297,12 +401,12 @@ public:
   // ===== Wire Utilities (static) =====
 
   static bool _wireDebugFlag;
-  static void _wireWriteTo(TwoWire *port, int address, uint8_t *cmdData, int cmdLen);
-  static uint8_t _wireReadFrom(TwoWire *port, int address, uint8_t *data, int len);
+  static void _wireWriteTo(RadioBus *bus, int address, uint8_t *cmdData, int cmdLen);
+  static uint8_t _wireReadFrom(RadioBus *bus, int address, uint8_t *data, int len);
 
-  // write a 16 bit value in High-Low order to the Wire.
-  static void _write16HL(TwoWire *port, uint16_t val);
-  static uint16_t _read16HL(TwoWire *port);
+  // write a 16 bit value in High-Low order to a buffer.
+  static void _write16HL(uint8_t *data, uint16_t val);
+  static uint16_t _read16HL(const uint8_t *data);
 
   /**
    * Enable low level i2c debugging information on Serial port.
@@ -313,24 +417,29 @@ public:
   /** check for a device on address.
    * @return true when i2c device answered.
    */
-  bool _wireExists(TwoWire *port, int address);
+  bool _wireExists(RadioBus *bus, int address);
+
+#if defined(ARDUINO)
+  bool _wireExists(TwoWire *port, int address);  ///< check for a device on a Wire port.
+#endif
 
   /**
    * Write and optionally read data on the i2c bus.
    * A debug output can be enabled using _wireDebug().
-   * @param port i2c port to be used.
+   * @param bus i2c bus to be used.
    * @param address i2c address to be used.
    * @param reg the register to be read (1 byte send).
    * @param data buffer array with received data. If this parameter is nullptr no data will be requested.
    * @param len length of data buffer.
    * @return number of register values received.
    */
-  int _wireRead(TwoWire *port, int address, uint8_t reg, uint8_t *data, int len);
+  int _wireRead(RadioBus *bus, int address, uint8_t reg, uint8_t *data, int len);
 
   /**
    * Write and optionally read data on the i2c bus.
+   * The data is read again until the first byte has the CTS flag (0x80) set.
    * A debug output can be enabled using _wireDebug().
-   * @param port i2c port to be used.
+   * @param bus i2c bus to be used.
    * @param address i2c address to be used.
    * @param cmdData array with data to be send.
    * @param cmdLen length of cmdData.
@@ -338,7 +447,7 @@ public:
    * @param len length of data buffer.
    * @return number of register values received.
    */
-  int _wireRead(TwoWire *port, int address, uint8_t *cmdData, int cmdLen, uint8_t *data, int len);
+  int _wireRead(RadioBus *bus, int address, uint8_t *cmdData, int cmdLen, uint8_t *data, int len);
 
 protected:
   bool _debugEnabled = false;      ///< Set by debugEnable() and controls debugging functionality.
@@ -359,15 +468,56 @@ protected:
   RADIO_FREQ _freqHigh;   ///< Highest frequency of the current selected band.
   RADIO_FREQ _freqSteps;  ///< Resolution of the tuner.
 
-  receiveRDSFunction _sendRDS;  ///< Registered RDS Function that is called on new available data.
+  receiveRDSFunction _sendRDS = nullptr;  ///< Registered RDS Function that is called on new available data.
+  receiveRDSExtFunction _sendRDSExt = nullptr;  ///< Registered RDS Function that is called with error levels.
+
+  // ----- RDS poll scheduler -----
+  // RDS groups are broadcasted every 87.6 msec (104 bits at 1187.5 bit/sec).
+  // While receiving groups the phase is tracked and the chip is polled only around the expected arrival.
+  // Without RDS the chip is probed fast for some time after tuning and slow later.
+
+  uint8_t _rdsPollMode = RADIO_RDSPOLL_ADAPTIVE;  ///< Set by setup(RADIO_RDSPOLL, ...).
+  bool _rdsTracking = false;                      ///< The arrival phase of RDS groups is known.
+  uint8_t _rdsMisses = 0;                         ///< Number of expected groups not received.
+  unsigned long _rdsNextPoll = 0;                 ///< Time in micros of the next poll.
+  unsigned long _rdsLastGroup = 0;                ///< Time in micros of the last received group.
+  unsigned long _rdsProbeStart = 0;               ///< Time in micros when fast probing started.
+
+  /// Return true when the chip should be checked for RDS data now.
+  bool _rdsPollDue();
+
+  /// Schedule the next poll after checking the chip.
+  /// @param received true when a new RDS group was received.
+  void _rdsPollDone(bool received);
+
+  // ----- Requests -----
+
+  volatile RADIO_FREQ _reqFreq = 0;       ///< Latest requested frequency.
+  volatile int8_t _reqVolume = 0;         ///< Latest requested volume.
+  volatile bool _reqFreqPending = false;  ///< A frequency request is not applied yet.
+  volatile bool _reqVolumePending = false;  ///< A volume request is not applied yet.
+  bool _reqBusy = false;                  ///< checkRequests() is applying a request.
+  uint16_t _reqDropped = 0;               ///< Number of requests replaced by a later one.
+
+  /// Return true when a running tune or seek should be stopped because a new frequency is requested.
+  /// Chips that can stop a tune or seek check this while waiting for the end.
+  bool _tuneAbort() { return (_reqFreqPending); };
+
+  /// Pass a received RDS group to the registered RDS functions.
+  /// The extended function gets all groups, the simple function only groups without uncorrectable blocks.
+  void _receiveRDS(uint16_t block1, uint16_t block2, uint16_t block3, uint16_t block4, uint8_t errors);
 
   void _printHex2(uint8_t val);   ///< Prints a byte as 2 character hexadecimal code with leading zeros.
   void _printHex4(uint16_t val);  ///< Prints a register as 4 character hexadecimal code with leading zeros.
 
   // i2c bus communication
-  TwoWire *_i2cPort;
+  RadioBus *_bus = nullptr;
   int _i2caddr;
 
+#if defined(ARDUINO)
+  RadioWireBus _wireBus;  ///< Adapter used by initWire().
+#endif
+
   // extra pins
   int _resetPin = -1;
 